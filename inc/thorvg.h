@@ -1,6 +1,7 @@
 #ifndef _THORVG_H_
 #define _THORVG_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -260,6 +261,25 @@ enum class Type : uint8_t
 };
 
 
+/**
+ * @brief Enumeration specifying the categories of the memory retained by the engine.
+ *
+ * @see Canvas::memory()
+ * @see Initializer::memory()
+ *
+ * @since Experimental API
+ */
+enum class MemoryType : uint8_t
+{
+    All = 0,      ///< The sum of all the categories below.
+    Geometry,     ///< The outlines and the spans of the paints, including the working memory pools of the engine.
+    Gradient,     ///< The color tables of the gradient fills.
+    Compositor,   ///< The cached offscreen buffers used for the compositions and the scene effects.
+    Image,        ///< The decoded bitmaps retained by the picture loaders.
+    Resource      ///< The source data and the parsed models (e.g. the Lottie compositions) retained by the loaders.
+};
+
+
 /**
  * @brief A data structure representing a point in two-dimensional space.
  */
@@ -461,6 +481,20 @@ public:
      */
     Paint* duplicate() const noexcept;
 
+    /**
+     * @brief Precomputes the renderer independent data of the paint and its descendants.
+     *
+     * This includes, for instance, the completion of the picture loading, the glyph outlines of the text
+     * and the trimmed paths of the shapes, which would otherwise be processed during the canvas update.
+     * It is intended for a detached paint being built on a worker thread before it is pushed to the canvas.
+     *
+     * @note The paint must not be shared with any other thread during this call.
+     *
+     * @see Canvas::swap()
+     * @since Experimental API
+     */
+    Result prepare() noexcept;
+
     /**
      * @brief Gets the opacity value of the object.
      *
@@ -732,6 +766,29 @@ public:
      */
     Result remove(Paint* paint = nullptr) noexcept;
 
+    /**
+     * @brief Replaces a paint object of the root scene with the given one in a single step.
+     *
+     * The @p paint takes over the position of the @p target in the root scene, and the @p target is removed from it as Canvas::remove() does.
+     * This allows to build a detached paint, such as a large Scene, on a worker thread while this canvas keeps drawing the previous content,
+     * and then to apply it between two frames without intermediate states. Paint::prepare() can be used on the worker thread in advance
+     * to reduce the remaining work of the following update.
+     *
+     * @param[in] target A pointer to the Paint object in the root scene to be replaced.
+     * @param[in] paint A pointer to the Paint object to be placed instead. It must not belong to any other scene.
+     *
+     * @retval Result::InvalidArguments In case a @c nullptr is passed as any of the arguments.
+     * @retval Result::InsufficientCondition If the canvas is drawing, the @p target is not in the root scene or the @p paint already has a parent.
+     *
+     * @note The @p paint must not be accessed by the worker thread anymore once it is passed to this function.
+     *
+     * @see Canvas::push()
+     * @see Canvas::remove()
+     * @see Paint::prepare()
+     * @since Experimental API
+     */
+    Result swap(Paint* target, Paint* paint) noexcept;
+
     /**
      * @brief Requests the canvas to update the paint for up-to-date render preparation.
      *
@@ -788,6 +845,70 @@ public:
      */
     Result sync() noexcept;
 
+    /**
+     * @brief Retrieves the amount of the memory retained for this canvas.
+     *
+     * The report covers the render data of the paints in the canvas, the compositor caches of its renderer
+     * and the resources of the loaders used by its pictures. A loader shared among several canvases is counted by each of them,
+     * while the working memory pools shared by the canvases are reported by Initializer::memory() only.
+     *
+     * @param[in] type The category of the memory to retrieve.
+     *
+     * @return The size of the memory in bytes.
+     *
+     * @note The amount depends on the engine. Engines without the memory accounting report only the loader resources.
+     * @see Canvas::purge()
+     * @since Experimental API
+     */
+    size_t memory(MemoryType type = MemoryType::All) const noexcept;
+
+    /**
+     * @brief Releases the memory caches retained by this canvas without invalidating its paints.
+     *
+     * This releases the compositor caches and the working memory pool of the renderer, and the render data (e.g. the spans)
+     * of the paints that are currently invisible due to a zero opacity. They are regenerated on demand by the following updates.
+     * It is intended to be called under memory pressure.
+     *
+     * @retval Result::InsufficientCondition If the canvas is not in the synced condition.
+     *
+     * @note The working memory pool may be shared with the other canvases created on the same thread. It is released only if all of them are synced.
+     * @see Canvas::memory()
+     * @since Experimental API
+     */
+    Result purge() noexcept;
+
+    /**
+     * @brief Sets the time budget of a frame, the rendering quality is traded for it.
+     *
+     * The time from the first update or draw of a frame to its sync() is measured. Whenever a frame overruns the budget,
+     * the quality is lowered by one level: the animations are built in the whole frames, then the blur effects take fewer passes,
+     * and finally the shapes are filled without anti-aliasing. The quality is restored by one level after several successive frames
+     * finished within half of the budget.
+     *
+     * A lowered quality level applies from the next frame to the paints updated in it, the unchanged paints keep their former result.
+     * When the level is raised, the paints prepared in a lower quality are updated again by the next update.
+     *
+     * @param[in] ms The budget of a frame in milliseconds. Zero disables it and restores the full quality (default).
+     *
+     * @retval Result::InvalidArguments In case @p ms is negative.
+     * @retval Result::InsufficientCondition If the canvas is not in the synced or damaged condition.
+     *
+     * @note The quality levels affect the software engine only.
+     * @see Canvas::quality()
+     * @since Experimental API
+     */
+    Result budget(float ms) noexcept;
+
+    /**
+     * @brief Retrieves the current rendering quality adjusted to the frame budget.
+     *
+     * @return The quality in the range [0 ~ 3], where 3 is the full quality and each step below it drops one more reduction.
+     *
+     * @see Canvas::budget()
+     * @since Experimental API
+     */
+    uint8_t quality() const noexcept;
+
     _TVG_DECLARE_PRIVATE_BASE(Canvas);
 };
 
@@ -1062,6 +1183,30 @@ public:
      */
     Result appendPath(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt) noexcept;
 
+    /**
+     * @brief Sets the path to refer to the given caller-owned buffers without copying them.
+     *
+     * Any previous path data is discarded. Unlike appendPath(), the engine reads the @p cmds and @p pts arrays directly,
+     * which avoids a copy of large paths that are rebuilt by the caller every frame.
+     *
+     * The buffers must remain valid and unchanged until the path is replaced or reset, or the shape is destroyed,
+     * and in any case until the drawing of the canvas that contains the shape is synced.
+     * To apply changes made to the buffers contents, call this function again, even with the same buffers.
+     * Any following path modification (e.g. lineTo()) copies the borrowed data into the shape first,
+     * and the duplicate() of the shape owns a copy of it as well.
+     *
+     * @param[in] cmds The array of the path commands.
+     * @param[in] cmdCnt The number of the path commands.
+     * @param[in] pts The array of the two-dimensional points.
+     * @param[in] ptsCnt The number of the points in the @p pts array.
+     *
+     * @retval Result::InvalidArguments In case any of the arrays is @c nullptr or any of the counts is zero.
+     *
+     * @see appendPath()
+     * @since Experimental API
+     */
+    Result borrowPath(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt) noexcept;
+
     /**
      * @brief Sets the stroke width for all of the figures from the path.
      *
@@ -1190,6 +1335,28 @@ public:
      */
     Result order(bool strokeFirst) noexcept;
 
+    /**
+     * @brief Sets the instances of the shape, drawing the same path multiple times by one shape.
+     *
+     * Each instance is drawn with its own transformation, which is applied on top of the shape's transformation.
+     * The path, stroke and fill properties are shared by all instances, so the memory and update costs grow with the number of unique geometries
+     * rather than the number of instances.
+     *
+     * @param[in] transforms The array of the transformation matrices, one per instance.
+     * @param[in] cnt The number of the instances. Pass zero to reset the instancing.
+     * @param[in] colors The optional array of the instance colors given in four consecutive values (r, g, b, a) per instance. It overrides the solid fill color of the shape.
+     * @param[in] opacities The optional array of the instance opacities in the range [0 ~ 255], applied to both the fill and the stroke.
+     *
+     * @retval Result::InvalidArguments In case @p transforms is @c nullptr and @p cnt > 0.
+     *
+     * @note Unlike Paint::opacity(), the fill and the stroke of a translucent instance are blended individually, without an intermediate composition.
+     * @note The software engine reuses the rasterized geometry among instances that differ only in translation.
+     * @note The engines without instancing support draw the shape once with its own transformation.
+     *
+     * @since Experimental API
+     */
+    Result instances(const Matrix* transforms, uint32_t cnt, const uint8_t* colors = nullptr, const uint8_t* opacities = nullptr) noexcept;
+
     /**
      * @brief Retrieves the current path data of the shape.
      *
@@ -1889,6 +2056,21 @@ public:
      */
     static const char* version(uint32_t* major, uint32_t* minor, uint32_t* micro) noexcept;
 
+    /**
+     * @brief Retrieves the amount of the memory retained by the engine globally.
+     *
+     * The report covers the working memory pools shared by the canvases and the resources of the cached loaders
+     * shared among the pictures and the fonts.
+     *
+     * @param[in] type The category of the memory to retrieve.
+     *
+     * @return The size of the memory in bytes.
+     *
+     * @see Canvas::memory()
+     * @since Experimental API
+     */
+    static size_t memory(MemoryType type = MemoryType::All) noexcept;
+
     _TVG_DISABLE_CTOR(Initializer);
 };
 
@@ -137,6 +137,24 @@ typedef enum {
 } Tvg_Colorspace;
 
 
+/**
+ * @brief Enumeration specifying the categories of the memory retained by the engine.
+ *
+ * @see tvg_canvas_get_memory()
+ * @see tvg_engine_get_memory()
+ *
+ * @since Experimental API
+ */
+typedef enum {
+    TVG_MEMORY_TYPE_ALL = 0,     ///< The sum of all the categories below.
+    TVG_MEMORY_TYPE_GEOMETRY,    ///< The outlines and the spans of the paints, including the working memory pools of the engine.
+    TVG_MEMORY_TYPE_GRADIENT,    ///< The color tables of the gradient fills.
+    TVG_MEMORY_TYPE_COMPOSITOR,  ///< The cached offscreen buffers used for the compositions and the scene effects.
+    TVG_MEMORY_TYPE_IMAGE,       ///< The decoded bitmaps retained by the picture loaders.
+    TVG_MEMORY_TYPE_RESOURCE     ///< The source data and the parsed models (e.g. the Lottie compositions) retained by the loaders.
+} Tvg_Memory_Type;
+
+
 /**
  * @brief Enumeration indicating the method used in the masking of two objects - the target and the source.
  *
@@ -383,6 +401,23 @@ TVG_API Tvg_Result tvg_engine_term();
 */
 TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t* micro, const char** version);
 
+
+/**
+* @brief Retrieves the amount of the memory retained by the engine globally.
+*
+* The report covers the working memory pools shared by the canvases and the resources of the cached loaders shared among the pictures and the fonts.
+*
+* @param[in] type The category of the memory to retrieve.
+* @param[out] size The size of the memory in bytes.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT In case a @c nullptr is passed as the argument.
+*
+* @see tvg_canvas_get_memory()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_engine_get_memory(Tvg_Memory_Type type, size_t* size);
+
 /** \} */   // end defgroup ThorVGCapi_Initializer
 
 
@@ -615,6 +650,27 @@ TVG_API Tvg_Result tvg_canvas_push_at(Tvg_Canvas* canvas, Tvg_Paint* target, Tvg
 TVG_API Tvg_Result tvg_canvas_remove(Tvg_Canvas* canvas, Tvg_Paint* paint);
 
 
+/**
+ * @brief Replaces a paint object of the root scene with the given one in a single step.
+ *
+ * The @p paint takes over the position of the @p target, which is removed from the root scene as tvg_canvas_remove() does.
+ * The @p paint can be built on a worker thread in advance, and then applied between two frames.
+ *
+ * @param[in] canvas A Tvg_Canvas object to swap the paints.
+ * @param[in] target A pointer to the Paint object in the root scene to be replaced.
+ * @param[in] paint A pointer to the Paint object to be placed instead.
+ *
+ * @return Tvg_Result enumeration.
+ * @retval TVG_RESULT_INVALID_ARGUMENT In case a @c nullptr is passed as any of the arguments.
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION If the canvas is drawing, the @p target is not in the root scene or the @p paint already has a parent.
+ *
+ * @see tvg_canvas_remove()
+ * @see tvg_paint_prepare()
+ * @since Experimental API
+ */
+TVG_API Tvg_Result tvg_canvas_swap(Tvg_Canvas* canvas, Tvg_Paint* target, Tvg_Paint* paint);
+
+
 /*!
 * @brief Updates all paints in a canvas.
 *
@@ -666,6 +722,77 @@ TVG_API Tvg_Result tvg_canvas_draw(Tvg_Canvas* canvas, bool clear);
 TVG_API Tvg_Result tvg_canvas_sync(Tvg_Canvas* canvas);
 
 
+/*!
+* @brief Retrieves the amount of the memory retained for the canvas.
+*
+* The report covers the render data of the paints in the canvas, the compositor caches of its renderer and the resources of the loaders used by its pictures.
+* The working memory pools shared by the canvases are reported by tvg_engine_get_memory() only.
+*
+* @param[in] canvas The Tvg_Canvas object to be queried.
+* @param[in] type The category of the memory to retrieve.
+* @param[out] size The size of the memory in bytes.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT In case a @c nullptr is passed as the argument.
+*
+* @see tvg_canvas_purge()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_canvas_get_memory(const Tvg_Canvas* canvas, Tvg_Memory_Type type, size_t* size);
+
+
+/*!
+* @brief Releases the memory caches retained by the canvas without invalidating its paints.
+*
+* This releases the compositor caches and the working memory pool of the renderer, and the render data of the paints that are currently invisible due to a zero opacity.
+* They are regenerated on demand by the following updates.
+*
+* @param[in] canvas The Tvg_Canvas object to be purged.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Canvas pointer.
+* @retval TVG_RESULT_INSUFFICIENT_CONDITION @p canvas is not in the synced condition.
+*
+* @see tvg_canvas_get_memory()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_canvas_purge(Tvg_Canvas* canvas);
+
+
+/*!
+* @brief Sets the time budget of a frame, the rendering quality is traded for it.
+*
+* Whenever a frame overruns the budget, measured from its first update or draw to the sync, the quality is lowered by one level.
+* It's restored by one level after several successive frames finished within half of the budget.
+*
+* @param[in] canvas The Tvg_Canvas object of the frames.
+* @param[in] ms The budget of a frame in milliseconds. Zero disables it and restores the full quality (default).
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Canvas pointer or a negative @p ms.
+* @retval TVG_RESULT_INSUFFICIENT_CONDITION @p canvas is not in the synced or damaged condition.
+*
+* @see tvg_canvas_get_quality()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_canvas_set_budget(Tvg_Canvas* canvas, float ms);
+
+
+/*!
+* @brief Retrieves the current rendering quality adjusted to the frame budget.
+*
+* @param[in] canvas The Tvg_Canvas object to be queried.
+* @param[out] quality The quality in the range [0 ~ 3], where 3 is the full quality.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT In case a @c nullptr is passed as the argument.
+*
+* @see tvg_canvas_set_budget()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_canvas_get_quality(const Tvg_Canvas* canvas, uint8_t* quality);
+
+
 /*!
 * @brief Sets the drawing region in the canvas.
 *
@@ -886,6 +1013,23 @@ TVG_API Tvg_Result tvg_paint_get_opacity(const Tvg_Paint* paint, uint8_t* opacit
 TVG_API Tvg_Paint* tvg_paint_duplicate(Tvg_Paint* paint);
 
 
+/*!
+* @brief Precomputes the renderer independent data of the given Tvg_Paint object and its descendants.
+*
+* This includes the completion of the picture loading, the glyph outlines of the text and the trimmed paths of the shapes.
+* It is intended for a detached paint being built on a worker thread before it is pushed to the canvas.
+*
+* @param[in] paint The Tvg_Paint object to be prepared.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT In case a @c nullptr is passed as the argument.
+*
+* @see tvg_canvas_swap()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_paint_prepare(Tvg_Paint* paint);
+
+
 /**
  * @brief Retrieves the axis-aligned bounding box (AABB) of the paint object in canvas space.
  *
@@ -1220,6 +1364,30 @@ TVG_API Tvg_Result tvg_shape_append_circle(Tvg_Paint* paint, float cx, float cy,
 TVG_API Tvg_Result tvg_shape_append_path(Tvg_Paint* paint, const Tvg_Path_Command* cmds, uint32_t cmdCnt, const Tvg_Point* pts, uint32_t ptsCnt);
 
 
+/*!
+* @brief Sets the path to refer to the given caller-owned buffers without copying them.
+*
+* Any previous path data is discarded and the engine reads the @p cmds and @p pts arrays directly.
+* The buffers must remain valid and unchanged until the path is replaced or reset, or the shape is deleted,
+* and in any case until the drawing of the canvas that contains the shape is synced.
+* To apply changes made to the buffers contents, call this function again.
+* Any following path modification copies the borrowed data into the shape first.
+*
+* @param[in] paint A Tvg_Paint pointer to the shape object.
+* @param[in] cmds The array of the path commands.
+* @param[in] cmdCnt The length of the @p cmds array.
+* @param[in] pts The array of the two-dimensional points.
+* @param[in] ptsCnt The length of the @p pts array.
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT A @c nullptr passed as the argument or @p cmdCnt or @p ptsCnt equal to zero.
+*
+* @see tvg_shape_append_path()
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_shape_borrow_path(Tvg_Paint* paint, const Tvg_Path_Command* cmds, uint32_t cmdCnt, const Tvg_Point* pts, uint32_t ptsCnt);
+
+
 /*!
 * @brief Retrieves the current path data of the shape.
 *
@@ -1533,6 +1701,25 @@ TVG_API Tvg_Result tvg_shape_get_fill_rule(const Tvg_Paint* paint, Tvg_Fill_Rule
 TVG_API Tvg_Result tvg_shape_set_paint_order(Tvg_Paint* paint, bool strokeFirst);
 
 
+/*!
+* @brief Sets the instances of the shape, drawing the same path multiple times by one shape.
+*
+* Each instance is drawn with its own transformation, which is applied on top of the shape's transformation.
+*
+* @param[in] paint A Tvg_Paint pointer to the shape object.
+* @param[in] transforms The array of the transformation matrices, one per instance.
+* @param[in] cnt The number of the instances. Pass zero to reset the instancing.
+* @param[in] colors The optional array of the instance colors given in four consecutive values (r, g, b, a) per instance.
+* @param[in] opacities The optional array of the instance opacities in the range [0 ~ 255].
+*
+* @return Tvg_Result enumeration.
+* @retval TVG_RESULT_INVALID_ARGUMENT An invalid Tvg_Paint pointer or @p transforms is @c NULL while @p cnt > 0.
+*
+* @since Experimental API
+*/
+TVG_API Tvg_Result tvg_shape_set_instances(Tvg_Paint* paint, const Tvg_Matrix* transforms, uint32_t cnt, const uint8_t* colors, const uint8_t* opacities);
+
+
 /*!
 * @brief Sets the gradient fill for all of the figures from the path.
 *
@@ -2618,6 +2805,94 @@ TVG_API Tvg_Result tvg_lottie_animation_tween(Tvg_Animation* animation, float fr
 */
 TVG_API Tvg_Result tvg_lottie_animation_assign(Tvg_Animation* animation, const char* layer, uint32_t ix, const char* var, float val);
 
+
+/*!
+* \brief Builds the next frame ahead while the current frame is rendered.
+*
+* When enabled, the animation predicts the next frame from the last frame step and the segment,
+* and builds its scene on a worker thread in parallel with the rendering of the current frame.
+* If the next requested frame is the predicted one, tvg_animation_set_frame() only swaps the scenes.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[in] on @c true to enable the prefetching, @c false to disable it.
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INSUFFICIENT_CONDITION If the animation is not loaded.
+* \retval TVG_RESULT_NOT_SUPPORTED When no worker threads are available.
+*
+* \note The prefetching animation keeps another set of the scene objects.
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_prefetch(Tvg_Animation* animation, bool on);
+
+
+/*!
+* \brief Keeps the rendered frames to draw them again in the next loops of the playback.
+*
+* While enabled, the requested frame numbers are rounded to the whole frames. Each frame is rendered
+* into an image of the picture size once, and the repeated frames are drawn by the images without
+* building and rasterizing the animation again. The frames are kept until the memory budget is used up.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[in] budget The memory budget of the rendered frames in bytes. @c 0 disables the caching and releases the frames.
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INSUFFICIENT_CONDITION If the animation is not loaded.
+* \retval TVG_RESULT_NOT_SUPPORTED When the software raster engine is not available.
+*
+* \note The frames are rendered by the software raster engine. A picture further scaled or rotated draws the scaled images.
+* \note The frames are released when the picture size is changed, or the slots or the expression variables are changed.
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_cache(Tvg_Animation* animation, uint32_t budget);
+
+
+/*!
+* \brief Draws the precomps of the unchanging contents with their rendered images.
+*
+* When enabled, a precomposition whose contents don't change in its active frame range, while its own transform does,
+* is rendered into an image once at its scale on the canvas. The following frames draw the image with the precomp transform
+* instead of building and rasterizing its contents again. The image is rendered again when the scale changes too much.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[in] on @c true to draw the images, @c false to draw the vector contents (default).
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INSUFFICIENT_CONDITION If the animation is not loaded.
+* \retval TVG_RESULT_NOT_SUPPORTED When the software raster engine is not available.
+*
+* \note The images are resampled by the rotations and the scales of the precomps, thus their edges could differ slightly from the vector contents.
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_freeze(Tvg_Animation* animation, bool on);
+
+
+/*!
+* \brief Renders the frames of the given range in parallel, for the offline export of the animation.
+*
+* The frames are rendered by the worker threads, each with its own build states and canvas over the parsed animation,
+* and delivered in order through the @p func on the calling thread. The frames start from @p begin and advance
+* by @p step until @p end, each is rendered into an image of the picture size. This doesn't change the current frame.
+*
+* \param[in] animation The Tvg_Animation pointer to the Lottie animation object.
+* \param[in] begin The first frame number of the range.
+* \param[in] end The frame number ending the range, exclusive.
+* \param[in] step The frame step between the frames.
+* \param[in] workers The number of the frames rendered at once, @c 0 uses all the worker threads.
+* \param[in] cs The color space of the frame images.
+* \param[in] func The callback function receiving the rendered frames in order. It returns @c false to stop the rendering.
+* \param[in] data Data passed to the @p func as its argument.
+*
+* \return Tvg_Result enumeration.
+* \retval TVG_RESULT_INSUFFICIENT_CONDITION If the animation is not loaded or the picture size is zero.
+* \retval TVG_RESULT_INVALID_ARGUMENT When the given range, step, color space or function is invalid.
+* \retval TVG_RESULT_NOT_SUPPORTED When the software raster engine is not available.
+*
+* \note The image buffer is valid only during the @p func call.
+* \note Experimental API
+*/
+TVG_API Tvg_Result tvg_lottie_animation_render(Tvg_Animation* animation, float begin, float end, float step, uint32_t workers, Tvg_Colorspace cs, bool (*func)(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data), void* data);
+
 /** \} */   // end addtogroup ThorVGCapi_LottieAnimation
 
 
@@ -58,6 +58,14 @@ TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t
     return TVG_RESULT_SUCCESS;
 }
 
+
+TVG_API Tvg_Result tvg_engine_get_memory(Tvg_Memory_Type type, size_t* size)
+{
+    if (!size) return TVG_RESULT_INVALID_ARGUMENT;
+    *size = Initializer::memory((MemoryType) type);
+    return TVG_RESULT_SUCCESS;
+}
+
 /************************************************************************/
 /* Canvas API                                                           */
 /************************************************************************/
@@ -132,6 +140,13 @@ TVG_API Tvg_Result tvg_canvas_remove(Tvg_Canvas* canvas, Tvg_Paint* paint)
 }
 
 
+TVG_API Tvg_Result tvg_canvas_swap(Tvg_Canvas* canvas, Tvg_Paint* target, Tvg_Paint* paint)
+{
+    if (canvas) return (Tvg_Result) reinterpret_cast<Canvas*>(canvas)->swap((Paint*) target, (Paint*) paint);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_canvas_update(Tvg_Canvas* canvas)
 {
     if (canvas) return (Tvg_Result) reinterpret_cast<Canvas*>(canvas)->update();
@@ -153,6 +168,36 @@ TVG_API Tvg_Result tvg_canvas_sync(Tvg_Canvas* canvas)
 }
 
 
+TVG_API Tvg_Result tvg_canvas_get_memory(const Tvg_Canvas* canvas, Tvg_Memory_Type type, size_t* size)
+{
+    if (!canvas || !size) return TVG_RESULT_INVALID_ARGUMENT;
+    *size = reinterpret_cast<const Canvas*>(canvas)->memory((MemoryType) type);
+    return TVG_RESULT_SUCCESS;
+}
+
+
+TVG_API Tvg_Result tvg_canvas_purge(Tvg_Canvas* canvas)
+{
+    if (canvas) return (Tvg_Result) reinterpret_cast<Canvas*>(canvas)->purge();
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
+TVG_API Tvg_Result tvg_canvas_set_budget(Tvg_Canvas* canvas, float ms)
+{
+    if (canvas) return (Tvg_Result) reinterpret_cast<Canvas*>(canvas)->budget(ms);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
+TVG_API Tvg_Result tvg_canvas_get_quality(const Tvg_Canvas* canvas, uint8_t* quality)
+{
+    if (!canvas || !quality) return TVG_RESULT_INVALID_ARGUMENT;
+    *quality = reinterpret_cast<const Canvas*>(canvas)->quality();
+    return TVG_RESULT_SUCCESS;
+}
+
+
 TVG_API Tvg_Result tvg_canvas_set_viewport(Tvg_Canvas* canvas, int32_t x, int32_t y, int32_t w, int32_t h)
 {
     if (canvas) return (Tvg_Result) reinterpret_cast<Canvas*>(canvas)->viewport(x, y, w, h);
@@ -246,6 +291,13 @@ TVG_API Tvg_Paint* tvg_paint_duplicate(Tvg_Paint* paint)
 }
 
 
+TVG_API Tvg_Result tvg_paint_prepare(Tvg_Paint* paint)
+{
+    if (paint) return (Tvg_Result) reinterpret_cast<Paint*>(paint)->prepare();
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_paint_set_opacity(Tvg_Paint* paint, uint8_t opacity)
 {
     if (paint) return (Tvg_Result) reinterpret_cast<Paint*>(paint)->opacity(opacity);
@@ -389,6 +441,13 @@ TVG_API Tvg_Result tvg_shape_append_path(Tvg_Paint* paint, const Tvg_Path_Comman
 }
 
 
+TVG_API Tvg_Result tvg_shape_borrow_path(Tvg_Paint* paint, const Tvg_Path_Command* cmds, uint32_t cmdCnt, const Tvg_Point* pts, uint32_t ptsCnt)
+{
+    if (paint) return (Tvg_Result) reinterpret_cast<Shape*>(paint)->borrowPath((const PathCommand*)cmds, cmdCnt, (const Point*)pts, ptsCnt);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_shape_get_path(const Tvg_Paint* paint, const Tvg_Path_Command** cmds, uint32_t* cmdsCnt, const Tvg_Point** pts, uint32_t* ptsCnt)
 {
     if (paint) return (Tvg_Result) reinterpret_cast<const Shape*>(paint)->path((const PathCommand**)cmds, cmdsCnt, (const Point**)pts, ptsCnt);
@@ -557,6 +616,13 @@ TVG_API Tvg_Result tvg_shape_set_paint_order(Tvg_Paint* paint, bool strokeFirst)
 }
 
 
+TVG_API Tvg_Result tvg_shape_set_instances(Tvg_Paint* paint, const Tvg_Matrix* transforms, uint32_t cnt, const uint8_t* colors, const uint8_t* opacities)
+{
+    if (paint) return (Tvg_Result) reinterpret_cast<Shape*>(paint)->instances(reinterpret_cast<const Matrix*>(transforms), cnt, colors, opacities);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_shape_set_gradient(Tvg_Paint* paint, Tvg_Gradient* gradient)
 {
     if (paint) return (Tvg_Result) reinterpret_cast<Shape*>(paint)->fill((Fill*)gradient);
@@ -1059,6 +1125,47 @@ TVG_API Tvg_Result tvg_lottie_animation_assign(Tvg_Animation* animation, const c
     return TVG_RESULT_NOT_SUPPORTED;
 }
 
+
+TVG_API Tvg_Result tvg_lottie_animation_prefetch(Tvg_Animation* animation, bool on)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation) return (Tvg_Result) reinterpret_cast<LottieAnimation*>(animation)->prefetch(on);
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
+
+TVG_API Tvg_Result tvg_lottie_animation_cache(Tvg_Animation* animation, uint32_t budget)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation) return (Tvg_Result) reinterpret_cast<LottieAnimation*>(animation)->cache(budget);
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
+
+TVG_API Tvg_Result tvg_lottie_animation_freeze(Tvg_Animation* animation, bool on)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation) return (Tvg_Result) reinterpret_cast<LottieAnimation*>(animation)->freeze(on);
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
+
+TVG_API Tvg_Result tvg_lottie_animation_render(Tvg_Animation* animation, float begin, float end, float step, uint32_t workers, Tvg_Colorspace cs, bool (*func)(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data), void* data)
+{
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+    if (animation && func) return (Tvg_Result) reinterpret_cast<LottieAnimation*>(animation)->render(begin, end, step, workers, static_cast<ColorSpace>(cs),
+                                                [func](const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data) { return func(buffer, w, h, frameNo, data); }, data);
+    return TVG_RESULT_INVALID_ARGUMENT;
+#endif
+    return TVG_RESULT_NOT_SUPPORTED;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +113,21 @@ struct Array
         count = reserved = 0;
     }
 
+    void swap(Array& rhs)
+    {
+        auto data = this->data;
+        auto count = this->count;
+        auto reserved = this->reserved;
+
+        this->data = rhs.data;
+        this->count = rhs.count;
+        this->reserved = rhs.reserved;
+
+        rhs.data = data;
+        rhs.count = count;
+        rhs.reserved = reserved;
+    }
+
     const T* begin() const
     {
         return data;
@@ -95,4 +95,20 @@ unsigned long djb2Encode(const char* str)
     return hash;
 }
 
+
+/************************************************************************/
+/* FNV-1a Implementation                                                */
+/************************************************************************/
+
+//the given hash continues the previous encoding, the binary data could be chained
+uint64_t fnv1aEncode(const void* data, size_t size, uint64_t hash)
+{
+    auto p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ namespace tvg
 {
     size_t b64Decode(const char* encoded, const size_t len, char** decoded);
     unsigned long djb2Encode(const char* str);
+    uint64_t fnv1aEncode(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL);
 }
 
 #endif  //_TVG_COMPRESSOR_H_
@@ -164,6 +164,39 @@ jerry_eval (const jerry_char_t *source_p, /**< source code */
   return jerry_return (ecma_op_eval_chars_buffer ((void *) &source_char, flags));
 } /* jerry_eval */
 
+/**
+ * Parse the code as an eval code, the returned script could be run multiple times by jerry_run
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return script object, or error value if the parsing has been failed.
+ */
+jerry_value_t
+jerry_parse (const jerry_char_t *source_p, /**< source code */
+             size_t source_size) /**< length of source code */
+{
+  parser_source_char_t source_char;
+  source_char.source_p = source_p;
+  source_char.source_size = source_size;
+
+  return jerry_return (ecma_op_eval_parse ((void *) &source_char));
+} /* jerry_parse */
+
+/**
+ * Run the script parsed by jerry_parse, same as jerry_eval with the script code
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return result of the script, may be error value.
+ */
+jerry_value_t
+jerry_run (const jerry_value_t script) /**< script object */
+{
+  return jerry_return (ecma_op_eval_run (ecma_get_object_from_value (script)));
+} /* jerry_run */
+
 /**
  * Get global object
  *
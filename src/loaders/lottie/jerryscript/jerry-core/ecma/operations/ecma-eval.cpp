@@ -94,6 +94,60 @@ ecma_op_eval_chars_buffer (void *source_p, /**< source code */
 #endif /* JERRY_PARSER */
 } /* ecma_op_eval_chars_buffer */
 
+/**
+ * Parse the code stored in continuous character buffer as an indirect 'eval' code
+ *
+ * Note:
+ *      the byte code is held by a script object, so that it could be run
+ *      multiple times by ecma_op_eval_run without parsing the code again
+ *
+ * @return script object - if success
+ *         ECMA_VALUE_ERROR - otherwise
+ */
+ecma_value_t
+ecma_op_eval_parse (void *source_p) /**< source code */
+{
+#if JERRY_PARSER
+  JERRY_ASSERT (source_p != NULL);
+
+  ECMA_CLEAR_LOCAL_PARSE_OPTS ();
+
+  ecma_compiled_code_t *bytecode_p = parser_parse_script (source_p, ECMA_PARSE_EVAL, NULL);
+
+  if (JERRY_UNLIKELY (bytecode_p == NULL))
+  {
+    return ECMA_VALUE_ERROR;
+  }
+
+  ecma_object_t *object_p = ecma_create_object (NULL, sizeof (ecma_extended_object_t), ECMA_OBJECT_TYPE_CLASS);
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  ext_object_p->u.cls.type = ECMA_OBJECT_CLASS_SCRIPT;
+  ECMA_SET_INTERNAL_VALUE_POINTER (ext_object_p->u.cls.u3.value, bytecode_p);
+
+  return ecma_make_object_value (object_p);
+#endif /* JERRY_PARSER */
+} /* ecma_op_eval_parse */
+
+/**
+ * Run the code parsed by ecma_op_eval_parse in the global scope, same as an indirect 'eval'
+ *
+ * @return ecma value
+ */
+ecma_value_t
+ecma_op_eval_run (ecma_object_t *script_p) /**< script object */
+{
+  JERRY_ASSERT (ecma_object_class_is (script_p, ECMA_OBJECT_CLASS_SCRIPT));
+
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) script_p;
+  ecma_compiled_code_t *bytecode_p;
+  bytecode_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_compiled_code_t, ext_object_p->u.cls.u3.value);
+
+  /* the byte code is released by the eval run, the script object keeps holding it */
+  ecma_bytecode_ref (bytecode_p);
+
+  return vm_run_eval (bytecode_p, ECMA_PARSE_EVAL);
+} /* ecma_op_eval_run */
+
 /**
  * @}
  * @}
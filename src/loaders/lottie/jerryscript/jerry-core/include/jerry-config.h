@@ -84,10 +84,10 @@
  *  0: Disable external context.
  *  1: Enable external context support.
  *
- * Default value: 0
+ * Default value: 1
  */
 #ifndef JERRY_EXTERNAL_CONTEXT
-#define JERRY_EXTERNAL_CONTEXT 0
+#define JERRY_EXTERNAL_CONTEXT 1
 #endif /* !defined (JERRY_EXTERNAL_CONTEXT) */
 
 /**
@@ -100,14 +100,13 @@ void jerry_port_sleep (uint32_t sleep_time);
 size_t jerry_port_context_alloc (size_t context_size);
 
 /**
- * Get the currently active context of the engine.
+ * The currently active context of the engine on the calling thread.
  *
- * This port function is called by jerry-core when JERRY_EXTERNAL_CONTEXT is enabled.
- * Otherwise this function is not used.
- *
- * @return the pointer to the currently used engine context.
+ * This port variable is read by jerry-core when JERRY_EXTERNAL_CONTEXT is enabled.
+ * It replaces the context getter function, since every engine access goes through it.
+ * Otherwise this variable is not used.
  */
-struct jerry_context_t *jerry_port_context_get (void);
+extern thread_local struct jerry_context_t *jerry_port_context_p;
 
 /**
  * Free the currently used context.
@@ -110,6 +110,83 @@ public:
      */
     Result assign(const char* layer, uint32_t ix, const char* var, float val);
 
+    /**
+     * @brief Builds the next frame ahead while the current frame is rendered.
+     *
+     * When enabled, the animation predicts the next frame from the last frame step and the segment,
+     * and builds its scene on a worker thread in parallel with the rendering of the current frame.
+     * If the next requested frame is the predicted one, Animation::frame() only swaps the scenes.
+     *
+     * @param[in] on @c true to enable the prefetching, @c false to disable it.
+     *
+     * @retval Result::InsufficientCondition If the animation is not loaded.
+     * @retval Result::NonSupport When no worker threads are available.
+     *
+     * @note The prefetching animation keeps another set of the scene objects.
+     * @note Experimental API
+     */
+    Result prefetch(bool on) noexcept;
+
+    /**
+     * @brief Keeps the rendered frames to draw them again in the next loops of the playback.
+     *
+     * While enabled, the requested frame numbers are rounded to the whole frames. Each frame is rendered
+     * into an image of the picture size once, and the repeated frames are drawn by the images without
+     * building and rasterizing the animation again. The frames are kept until the memory budget is used up.
+     *
+     * @param[in] budget The memory budget of the rendered frames in bytes. @c 0 disables the caching and releases the frames.
+     *
+     * @retval Result::InsufficientCondition If the animation is not loaded.
+     * @retval Result::NonSupport When the software raster engine is not available.
+     *
+     * @note The frames are rendered by the software raster engine. A picture further scaled or rotated draws the scaled images.
+     * @note The frames are released when the picture size is changed, or the slots or the expression variables are changed.
+     * @note Experimental API
+     */
+    Result cache(uint32_t budget) noexcept;
+
+    /**
+     * @brief Draws the precomps of the unchanging contents with their rendered images.
+     *
+     * When enabled, a precomposition whose contents don't change in its active frame range, while its own transform does,
+     * is rendered into an image once at its scale on the canvas. The following frames draw the image with the precomp transform
+     * instead of building and rasterizing its contents again. The image is rendered again when the scale changes too much.
+     *
+     * @param[in] on @c true to draw the images, @c false to draw the vector contents (default).
+     *
+     * @retval Result::InsufficientCondition If the animation is not loaded.
+     * @retval Result::NonSupport When the software raster engine is not available.
+     *
+     * @note The images are resampled by the rotations and the scales of the precomps, thus their edges could differ slightly from the vector contents.
+     * @note Experimental API
+     */
+    Result freeze(bool on) noexcept;
+
+    /**
+     * @brief Renders the frames of the given range in parallel, for the offline export of the animation.
+     *
+     * The frames are rendered by the worker threads, each with its own build states and canvas over the parsed animation,
+     * and delivered in order through the @p func on the calling thread. The frames start from @p begin and advance
+     * by @p step until @p end, each is rendered into an image of the picture size. This doesn't change the current frame.
+     *
+     * @param[in] begin The first frame number of the range.
+     * @param[in] end The frame number ending the range, exclusive.
+     * @param[in] step The frame step between the frames, e.g. the frame rate of the animation divided by the frame rate of the export.
+     * @param[in] workers The number of the frames rendered at once, @c 0 uses all the worker threads.
+     * @param[in] cs The color space of the frame images.
+     * @param[in] func The callback function receiving the rendered frames in order. It returns @c false to stop the rendering.
+     * @param[in] data Data passed to the @p func as its argument.
+     *
+     * @retval Result::InsufficientCondition If the animation is not loaded or the picture size is zero.
+     * @retval Result::InvalidArguments When the given range, step, color space or function is invalid.
+     * @retval Result::NonSupport When the software raster engine is not available.
+     *
+     * @note The frames are rendered by the software raster engine. The image buffer is valid only during the @p func call.
+     * @note The workers are limited by the worker threads of the engine. The animation using the expressions renders the frames one by one.
+     * @note Experimental API
+     */
+    Result render(float begin, float end, float step, uint32_t workers, ColorSpace cs, std::function<bool(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data)> func, void* data) noexcept;
+
     /**
      * @brief Creates a new LottieAnimation object.
      *
@@ -20,6 +20,7 @@
  * SOFTWARE.
  */
 
+#include <cmath>
 #include "tvgCommon.h"
 #include "thorvg_lottie.h"
 #include "tvgLottieLoader.h"
@@ -63,8 +64,9 @@ Result LottieAnimation::tween(float from, float to, float progress) noexcept
 {
     auto loader = PICTURE(pImpl->picture)->loader;
     if (!loader) return Result::InsufficientCondition;
+    PICTURE(pImpl->picture)->wait();
     if (!static_cast<LottieLoader*>(loader)->tween(from, to, progress)) return Result::InsufficientCondition;
-    PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
+    PICTURE(pImpl->picture)->changed = true;
     return Result::Success;
 }
 
@@ -100,6 +102,68 @@ Result LottieAnimation::assign(const char* layer, uint32_t ix, const char* var,
 }
 
 
+Result LottieAnimation::prefetch(bool on) noexcept
+{
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    //nothing could be built in parallel with the rendering
+    if (on && TaskScheduler::threads() == 0) return Result::NonSupport;
+
+    if (!static_cast<LottieLoader*>(loader)->prefetch(on)) return Result::InsufficientCondition;
+    return Result::Success;
+}
+
+
+Result LottieAnimation::cache(TVG_UNUSED uint32_t budget) noexcept
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    if (!static_cast<LottieLoader*>(loader)->cache(budget)) return Result::InsufficientCondition;
+    return Result::Success;
+#else
+    return Result::NonSupport;
+#endif
+}
+
+
+Result LottieAnimation::freeze(TVG_UNUSED bool on) noexcept
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    if (!static_cast<LottieLoader*>(loader)->freeze(on)) return Result::InsufficientCondition;
+    PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
+    return Result::Success;
+#else
+    return Result::NonSupport;
+#endif
+}
+
+
+Result LottieAnimation::render(TVG_UNUSED float begin, TVG_UNUSED float end, TVG_UNUSED float step, TVG_UNUSED uint32_t workers, TVG_UNUSED ColorSpace cs, TVG_UNUSED std::function<bool(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data)> func, TVG_UNUSED void* data) noexcept
+{
+#ifdef THORVG_SW_RASTER_SUPPORT
+    if (!func || cs == ColorSpace::Grayscale8 || cs == ColorSpace::Unknown) return Result::InvalidArguments;
+    if (!std::isfinite(begin) || !std::isfinite(end) || !std::isfinite(step) || !(step > 0.0f) || begin > end) return Result::InvalidArguments;
+
+    auto loader = PICTURE(pImpl->picture)->loader;
+    if (!loader) return Result::InsufficientCondition;
+
+    //the picture might not be resized yet
+    float w, h;
+    PICTURE(pImpl->picture)->size(&w, &h);
+
+    return static_cast<LottieLoader*>(loader)->render(begin, end, step, workers, cs, w, h, func, data);
+#else
+    return Result::NonSupport;
+#endif
+}
+
+
 LottieAnimation* LottieAnimation::gen() noexcept
 {
     return new LottieAnimation;
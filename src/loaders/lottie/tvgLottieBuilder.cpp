@@ -32,8 +32,22 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+static bool _resolve(LottieComposition* comp, LottieLayer* precomp);
 static bool _buildComposition(LottieComposition* comp, LottieLayer* parent);
 static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx);
+static void _release(LottieLayer* layer, bool retain);
+
+
+//rasterize the frozen precomp again if its scale is changed more than this ratio
+static constexpr float RASTER_SCALE_TOLERANCE = 1.25f;
+//the frozen precomp larger than this is drawn with its vector contents
+static constexpr float RASTER_MAX_PIXELS = 2048.0f * 2048.0f;
+
+
+static float _scale(const Matrix& m)
+{
+    return std::max(sqrtf(m.e11 * m.e11 + m.e21 * m.e21), sqrtf(m.e12 * m.e12 + m.e22 * m.e22));
+}
 
 
 static void _rotate(LottieTransform* transform, float frameNo, Matrix& m, float angle, Tween& tween, LottieExpressions* exps)
@@ -341,8 +355,90 @@ static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx)
 }
 
 
-static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx)
+/* Draw the copies of the repeaters by one shape instancing the path. The copies in the stacking order
+   take the transforms and the opacities of the duplicated shapes, then the path is outlined once. */
+static bool _instance(LottieGroup* parent, Shape* path, RenderContext* ctx)
 {
+    auto propagator = ctx->propagator;
+
+    if (propagator->strokeWidth() > 0.0f) {
+        //the translucent copy composes its fill and stroke together, the instance blends them individually
+        uint8_t a;
+        propagator->fill(nullptr, nullptr, nullptr, &a);
+        if (propagator->fill() || a > 0) return false;
+        //the strokes of the rotated or scaled copies are outlined one by one, slower than by the separate shapes
+        ARRAY_FOREACH(p, ctx->repeaters) {
+            if (!tvg::zero(p->rotation) || !tvg::equal(p->scale.x, 100.0f) || !tvg::equal(p->scale.y, 100.0f)) return false;
+        }
+    }
+
+    Array<Matrix> transforms, copies;
+    Array<uint8_t> opacities, copyOpacities;
+    transforms.push(propagator->transform());
+    opacities.push(propagator->opacity());
+
+    ARRAY_REVERSE_FOREACH(repeater, ctx->repeaters) {
+        Matrix inv;
+        inverse(&repeater->transform, &inv);
+
+        copies.reserve(repeater->cnt * transforms.count);
+        copyOpacities.reserve(copies.reserved);
+
+        for (int i = 0; i < repeater->cnt; ++i) {
+            auto multiplier = repeater->offset + static_cast<float>(i);
+            auto opacity = tvg::lerp<uint8_t>(repeater->startOpacity, repeater->endOpacity, static_cast<float>(i + 1) / repeater->cnt);
+
+            auto m = tvg::identity();
+            translate(&m, repeater->position * multiplier + repeater->anchor);
+            scale(&m, {powf(repeater->scale.x * 0.01f, multiplier), powf(repeater->scale.y * 0.01f, multiplier)});
+            rotate(&m, repeater->rotation * multiplier);
+            translateR(&m, -repeater->anchor);
+            m = repeater->transform * m;
+
+            for (uint32_t j = 0; j < transforms.count; ++j) {
+                copies.push(m * (inv * transforms[j]));
+                copyOpacities.push(MULTIPLY(opacities[j], opacity));
+            }
+        }
+
+        transforms.clear();
+        opacities.clear();
+
+        //the copies in the pushing order
+        if (repeater->inorder) {
+            for (uint32_t i = 0; i < copies.count; ++i) {
+                transforms.push(copies[i]);
+                opacities.push(copyOpacities[i]);
+            }
+        } else {
+            for (auto i = copies.count; i > 0; --i) {
+                transforms.push(copies[i - 1]);
+                opacities.push(copyOpacities[i - 1]);
+            }
+        }
+        copies.clear();
+        copyOpacities.clear();
+    }
+
+    if (transforms.empty()) return true;
+
+    //the path pooled by the lottie shape takes the properties of the propagator
+    auto rpath = SHAPE(path)->rs.path;
+    PAINT(propagator)->duplicate(path);
+    SHAPE(path)->rs.path = rpath;
+    path->transform(tvg::identity());
+    path->opacity(255);
+    path->instances(transforms.data, transforms.count, nullptr, opacities.data);
+    parent->scene->push(path);
+
+    return true;
+}
+
+
+static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx, bool instancing)
+{
+    if (instancing && _instance(parent, path, ctx)) return;
+
     Array<Shape*> propagators;
     propagators.push(ctx->propagator);
     Array<Shape*> shapes;
@@ -394,18 +490,19 @@ static void _repeat(LottieGroup* parent, Shape* path, RenderContext* ctx)
 void LottieBuilder::appendRect(Shape* shape, Point& pos, Point& size, float r, bool clockwise, RenderContext* ctx)
 {
     auto temp = (ctx->offset) ? Shape::gen() : shape;
-    auto cnt = SHAPE(temp)->rs.path.pts.count;
+    auto cnt = SHAPE(temp)->rs.path->pts.count;
 
     temp->appendRect(pos.x, pos.y, size.x, size.y, r, r, clockwise);
 
     if (ctx->transform) {
-        for (auto i = cnt; i < SHAPE(temp)->rs.path.pts.count; ++i) {
-            SHAPE(temp)->rs.path.pts[i] *= *ctx->transform;
+        auto& pts = SHAPE(temp)->rs.path.edit().pts;
+        for (auto i = cnt; i < pts.count; ++i) {
+            pts[i] *= *ctx->transform;
         }
     }
 
     if (ctx->offset) {
-        ctx->offset->modifyRect(SHAPE(temp)->rs.path, SHAPE(shape)->rs.path);
+        ctx->offset->modifyRect(SHAPE(temp)->rs.path.edit(), SHAPE(shape)->rs.path.edit());
         delete(temp);
     }
 }
@@ -431,7 +528,7 @@ void LottieBuilder::updateRect(LottieGroup* parent, LottieObject** child, float
         auto shape = rect->pooling();
         shape->reset();
         appendRect(shape, pos, size, r, rect->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, shape, ctx, instancing);
     }
 }
 
@@ -440,13 +537,14 @@ static void _appendCircle(Shape* shape, Point& center, Point& radius, bool clock
 {
     if (ctx->offset) ctx->offset->modifyEllipse(radius);
 
-    auto cnt = SHAPE(shape)->rs.path.pts.count;
+    auto cnt = SHAPE(shape)->rs.path->pts.count;
 
     shape->appendCircle(center.x, center.y, radius.x, radius.y, clockwise);
 
     if (ctx->transform) {
-        for (auto i = cnt; i < SHAPE(shape)->rs.path.pts.count; ++i) {
-            SHAPE(shape)->rs.path.pts[i] *= *ctx->transform;
+        auto& pts = SHAPE(shape)->rs.path.edit().pts;
+        for (auto i = cnt; i < pts.count; ++i) {
+            pts[i] *= *ctx->transform;
         }
     }
 }
@@ -465,25 +563,34 @@ void LottieBuilder::updateEllipse(LottieGroup* parent, LottieObject** child, flo
         auto shape = ellipse->pooling();
         shape->reset();
         _appendCircle(shape, pos, size, ellipse->clockwise, ctx);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, shape, ctx, instancing);
     }
 }
 
 
+//the modified output is kept by the shape to be reused while its input doesn't change
+static LottieModifierCache* _modified(LottieShape* shape, RenderContext* ctx)
+{
+    if (!ctx->modifier) return nullptr;
+    if (!shape->modified) shape->modified = new LottieModifierCache;
+    return shape->modified;
+}
+
+
 void LottieBuilder::updatePath(LottieGroup* parent, LottieObject** child, float frameNo, TVG_UNUSED Inlist<RenderContext>& contexts, RenderContext* ctx)
 {
     auto path = static_cast<LottiePath*>(*child);
 
     if (ctx->repeaters.empty()) {
         _draw(parent, path, ctx);
-        if (path->pathset(frameNo, SHAPE(ctx->merging)->rs.path, ctx->transform, tween, exps, ctx->modifier)) {
+        if (path->pathset(frameNo, SHAPE(ctx->merging)->rs.path.edit(), ctx->transform, tween, exps, ctx->modifier, _modified(path, ctx))) {
             PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
         }
     } else {
         auto shape = path->pooling();
         shape->reset();
-        path->pathset(frameNo, SHAPE(shape)->rs.path, ctx->transform, tween, exps, ctx->modifier);
-        _repeat(parent, shape, ctx);
+        path->pathset(frameNo, SHAPE(shape)->rs.path.edit(), ctx->transform, tween, exps, ctx->modifier, _modified(path, ctx));
+        _repeat(parent, shape, ctx, instancing);
     }
 }
 
@@ -535,11 +642,11 @@ void LottieBuilder::updateStar(LottiePolyStar* star, float frameNo, Matrix* tran
     }
 
     if (tvg::zero(innerRoundness) && tvg::zero(outerRoundness)) {
-        SHAPE(shape)->rs.path.pts.reserve(numPoints + 2);
-        SHAPE(shape)->rs.path.cmds.reserve(numPoints + 3);
+        SHAPE(shape)->rs.path.edit().pts.reserve(numPoints + 2);
+        SHAPE(shape)->rs.path.edit().cmds.reserve(numPoints + 3);
     } else {
-        SHAPE(shape)->rs.path.pts.reserve(numPoints * 3 + 2);
-        SHAPE(shape)->rs.path.cmds.reserve(numPoints + 3);
+        SHAPE(shape)->rs.path.edit().pts.reserve(numPoints * 3 + 2);
+        SHAPE(shape)->rs.path.edit().cmds.reserve(numPoints + 3);
         hasRoundness = true;
     }
 
@@ -597,7 +704,10 @@ void LottieBuilder::updateStar(LottiePolyStar* star, float frameNo, Matrix* tran
     }
     shape->close();
 
-    if (ctx->modifier) ctx->modifier->modifyPolystar(SHAPE(shape)->rs.path, SHAPE(merging)->rs.path, outerRoundness, hasRoundness);
+    if (ctx->modifier) {
+        if (shape == merging) ctx->modifier->modifyPolystar(SHAPE(shape)->rs.path.edit(), SHAPE(merging)->rs.path.edit(), outerRoundness, hasRoundness);
+        else ctx->modifier->cachedPolystar(*_modified(star, ctx), SHAPE(shape)->rs.path.edit(), SHAPE(merging)->rs.path.edit(), outerRoundness, hasRoundness);
+    }
 }
 
 
@@ -626,11 +736,11 @@ void LottieBuilder::updatePolygon(LottieGroup* parent, LottiePolyStar* star, flo
     } else {
         shape = merging;
         if (hasRoundness) {
-            SHAPE(shape)->rs.path.pts.reserve(ptsCnt * 3 + 2);
-            SHAPE(shape)->rs.path.cmds.reserve(ptsCnt + 3);
+            SHAPE(shape)->rs.path.edit().pts.reserve(ptsCnt * 3 + 2);
+            SHAPE(shape)->rs.path.edit().cmds.reserve(ptsCnt + 3);
         } else {
-            SHAPE(shape)->rs.path.pts.reserve(ptsCnt + 2);
-            SHAPE(shape)->rs.path.cmds.reserve(ptsCnt + 3);
+            SHAPE(shape)->rs.path.edit().pts.reserve(ptsCnt + 2);
+            SHAPE(shape)->rs.path.edit().cmds.reserve(ptsCnt + 3);
         }
     }
 
@@ -665,7 +775,10 @@ void LottieBuilder::updatePolygon(LottieGroup* parent, LottiePolyStar* star, flo
     }
     shape->close();
 
-    if (ctx->modifier) ctx->modifier->modifyPolystar(SHAPE(shape)->rs.path, SHAPE(merging)->rs.path, 0.0f, false);
+    if (ctx->modifier) {
+        if (shape == merging) ctx->modifier->modifyPolystar(SHAPE(shape)->rs.path.edit(), SHAPE(merging)->rs.path.edit(), 0.0f, false);
+        else ctx->modifier->cachedPolystar(*_modified(star, ctx), SHAPE(shape)->rs.path.edit(), SHAPE(merging)->rs.path.edit(), 0.0f, false);
+    }
 }
 
 
@@ -692,7 +805,7 @@ void LottieBuilder::updatePolystar(LottieGroup* parent, LottieObject** child, fl
         shape->reset();
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), shape, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), shape, ctx, tween, exps);
-        _repeat(parent, shape, ctx);
+        _repeat(parent, shape, ctx, instancing);
     }
 }
 
@@ -703,7 +816,7 @@ void LottieBuilder::updateRoundedCorner(TVG_UNUSED LottieGroup* parent, LottieOb
     auto r = roundedCorner->radius(frameNo, tween, exps);
     if (r < LottieRoundnessModifier::ROUNDNESS_EPSILON) return;
 
-    if (!ctx->roundness) ctx->roundness = new LottieRoundnessModifier(&buffer, r);
+    if (!ctx->roundness) ctx->roundness = new LottieRoundnessModifier(&roundedCorner->buffer, r);
     else if (ctx->roundness->r < r) ctx->roundness->r = r;
 
     ctx->update(ctx->roundness);
@@ -840,13 +953,21 @@ void LottieBuilder::updateChildren(LottieGroup* parent, float frameNo, Inlist<Re
 
 void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo)
 {
+    if (precomp->deferred && !_resolve(comp, precomp)) return;
     if (precomp->children.empty()) return;
 
     frameNo = precomp->remap(comp, frameNo, exps);
 
-    ARRAY_REVERSE_FOREACH(c, precomp->children) {
-        auto child = static_cast<LottieLayer*>(*c);
-        if (!child->matteSrc) updateLayer(comp, precomp->scene, child, frameNo);
+    auto scale = precomp->cache.scale * _scale(precomp->cache.matrix);
+
+    //the expressions could refer to the precomp, the contents might differ by the reference
+    if (comp->expressions || !updateInstance(precomp, frameNo, scale)) {
+        ARRAY_FOREACH(c, precomp->children) static_cast<LottieLayer*>(*c)->cache.scale = scale;
+
+        ARRAY_REVERSE_FOREACH(c, precomp->children) {
+            auto child = static_cast<LottieLayer*>(*c);
+            if (!child->matteSrc) updateLayer(comp, precomp->scene, child, frameNo);
+        }
     }
 
     //clip the layer viewport
@@ -868,6 +989,111 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 }
 
 
+/* The precomps referring to the same asset at the same frame and scale build the identical contents.
+   The first one builds them and the others copy its paints sharing the path data. The copy is
+   retained by the reference and replaced only when its frame or scale changes, so the renderer
+   could keep its render data as well. The steady contents are the same in any frame. */
+bool LottieBuilder::updateInstance(LottieLayer* precomp, float frameNo, float scale)
+{
+    auto asset = precomp->children.first();
+    if (!static_cast<LottieLayer*>(asset)->shared || tweening()) return false;
+
+    auto& cache = precomp->cache;
+
+    if (!cache.instance || (!precomp->steady && !equal(cache.instanceNo, frameNo)) || !equal(cache.instanceScale, scale)) {
+        LottieInstance* source = nullptr;
+        ARRAY_FOREACH(p, instances) {
+            if (p->asset == asset && equal(p->frameNo, frameNo) && equal(p->scale, scale)) {
+                source = p;
+                break;
+            }
+        }
+        if (!source) {
+            instances.push({asset, frameNo, scale, precomp->scene});
+            return false;
+        }
+        if (cache.instance) cache.instance->unref();
+        cache.instance = Scene::gen();
+        cache.instance->ref();
+        for (auto paint : source->scene->paints()) cache.instance->push(paint->duplicate());
+        cache.instanceNo = frameNo;
+        cache.instanceScale = scale;
+    }
+
+    precomp->scene->push(cache.instance);
+    return true;
+}
+
+
+/* Draw the frozen precomp with the raster of its contents. The contents are rendered once
+   at the scale of the precomp on the canvas, and again only when the scale changes too much. */
+bool LottieBuilder::updateFrozen(LottieComposition* comp, LottieLayer* precomp, float frameNo)
+{
+    auto& cache = precomp->cache;
+    auto scale = cache.scale * _scale(cache.matrix);
+    auto w = ceilf(precomp->w * scale);
+    auto h = ceilf(precomp->h * scale);
+
+    if (w < 1.0f || h < 1.0f || w * h > RASTER_MAX_PIXELS) return false;
+
+    if (!cache.raster || scale > cache.rasterScale * RASTER_SCALE_TOLERANCE || scale * RASTER_SCALE_TOLERANCE < cache.rasterScale) {
+        if (cache.raster) cache.raster->unref();
+        cache.raster = nullptr;
+
+        auto canvas = SwCanvas::gen();
+        if (!canvas) return false;
+
+        //build the contents in the raster space
+        auto scene = precomp->scene;
+        auto matrix = cache.matrix;
+        cache.matrix = {scale, 0, 0, 0, scale, 0, 0, 0, 1};
+        precomp->scene = Scene::gen();
+        precomp->scene->transform(cache.matrix);
+
+        //the contents built in the raster space are not shared with the other references
+        auto shares = instances.count;
+
+        if (!tweening()) updatePrecomp(comp, precomp, frameNo);
+        else updatePrecomp(comp, precomp, frameNo, tween);
+
+        instances.count = shares;
+
+        //the renderer of this thread can't wait for the busy workers, the pushed paints are prepared as well
+        auto inplace = TaskScheduler::inplace(true);
+
+        //the copy is drawn, the retained paints mustn't be bound to the offscreen renderer
+        auto iw = uint32_t(w), ih = uint32_t(h);
+        auto buffer = tvg::calloc<uint32_t*>(iw * ih, sizeof(uint32_t));
+        canvas->target(buffer, iw, iw, ih, ColorSpace::ARGB8888);
+        canvas->push(precomp->scene->duplicate());
+        if (canvas->draw() == Result::Success) canvas->sync();
+        delete(canvas);
+
+        TaskScheduler::inplace(inplace);
+        delete(precomp->scene);
+        precomp->scene = scene;
+        cache.matrix = matrix;
+
+        //the contents are drawn with the raster, the other references of the shared asset build them again
+        ARRAY_FOREACH(p, precomp->children) _release(static_cast<LottieLayer*>(*p), false);
+
+        auto picture = Picture::gen();
+        picture->load(buffer, iw, ih, ColorSpace::ARGB8888, true);
+        picture->ref();
+        tvg::free(buffer);
+
+        cache.raster = picture;
+        cache.rasterScale = scale;
+    }
+
+    auto inv = 1.0f / cache.rasterScale;
+    cache.raster->transform({inv, 0, 0, 0, inv, 0, 0, 0, 1});
+    precomp->scene->push(cache.raster);
+
+    return true;
+}
+
+
 void LottieBuilder::updateSolid(LottieLayer* layer)
 {
     auto solidFill = layer->statical.pooling(true);
@@ -919,6 +1145,27 @@ static void _fontText(TextDocument& doc, Scene* scene)
 }
 
 
+//take a scene of the text layout cleared from the former one
+static Scene* _pooling(LottieRenderPooler<Scene>& pooler)
+{
+    auto scene = pooler.pooling();
+    scene->remove();
+    return scene;
+}
+
+
+//push the text group having the glyphs, then take a new one. The empty group is reused.
+static Scene* _group(LottieText* text, Scene* scene, Scene* group, const Point& cursor)
+{
+    if (!group->paints().empty()) {
+        scene->push(group);
+        group = _pooling(text->groups);
+    }
+    group->transform({1.0f, 0.0f, cursor.x, 0.0f, 1.0f, cursor.y, 0.0f, 0.0f, 1.0f});
+    return group;
+}
+
+
 void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
 {
     auto text = static_cast<LottieText*>(layer->children.first());
@@ -933,11 +1180,34 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
         return;
     }
 
+    auto glyphs = text->glyphs(doc);
+    auto& cache = layer->cache;
+
+    //the same document is drawn with the paints laid out before
+    if (cache.text && cache.text->refCnt() == 1 && cache.revision == text->layout.revision) {
+        layer->scene->push(cache.text);
+        return;
+    }
+    cache.text = nullptr;
+
+    //the paints detached from the former layout are taken again
+    ARRAY_FOREACH(p, text->lines.pooler) {
+        if ((*p)->refCnt() == 1) (*p)->remove();
+    }
+    ARRAY_FOREACH(p, text->groups.pooler) {
+        if ((*p)->refCnt() == 1) (*p)->remove();
+    }
+
+    //the unchanged glyphs, positions and styles are retained with the text body
+    auto retain = text->ranges.empty() && !text->followPath && !tweening();
+    auto body = _pooling(text->lines);
+    layer->scene->push(body);
+
     auto scale = doc.size;
     Point cursor{};
-    //TODO: Need to revise to alloc scene / textgroup when they are really necessary
-    auto scene = Scene::gen();
-    Scene* textGroup = Scene::gen();
+    auto scene = _pooling(text->lines);
+    body->push(scene);
+    auto textGroup = _pooling(text->groups);
     int line = 0;
     int space = 0;
     auto lineSpacing = 0.0f;
@@ -961,15 +1231,9 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
             layout.x += doc.justify * (-1.0f * doc.bbox.size.x + cursor.x * scale);
 
             //new text group, single scene based on text-grouping
-            scene->push(textGroup);
-            textGroup = Scene::gen();
-            textGroup->translate(cursor.x, cursor.y);
-
-            scene->translate(layout.x, layout.y);
-            scene->scale(scale);
+            textGroup = _group(text, scene, textGroup, cursor);
 
-            layer->scene->push(scene);
-            scene = nullptr;
+            scene->transform({scale, 0.0f, layout.x, 0.0f, scale, layout.y, 0.0f, 0.0f, 1.0f});
 
             if (*p == '\0') break;
             ++p;
@@ -978,7 +1242,8 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
             lineSpacing = 0.0f;
 
             //new text group, single scene for each line
-            scene = Scene::gen();
+            scene = _pooling(text->lines);
+            body->push(scene);
             cursor.x = 0.0f;
             cursor.y = (++line * doc.height + totalLineSpacing) / scale;
             continue;
@@ -988,179 +1253,167 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
             ++space;
             if (textGrouping == LottieText::AlignOption::Group::Word) {
                 //new text group, single scene for each word
-                scene->push(textGroup);
-                textGroup = Scene::gen();
-                textGroup->translate(cursor.x, cursor.y);
+                textGroup = _group(text, scene, textGroup, cursor);
             }
         }
 
         /* all lowercase letters are converted to uppercase in the "t" text field, making the "ca" value irrelevant, thus AllCaps is nothing to do.
            So only convert lowercase letters to uppercase (for 'SmallCaps' an extra scaling factor applied) */
-        auto code = p;
         auto capScale = 1.0f;
-        char capCode;
-        if ((unsigned char)(p[0]) < 0x80 && doc.caps) {
-            if (*p >= 'a' && *p <= 'z') {
-                capCode = *p + 'A' - 'a';
-                code = &capCode;
-                if (doc.caps == 2) capScale = 0.7f;
-            }
+        if ((unsigned char)(p[0]) < 0x80 && doc.caps == 2 && *p >= 'a' && *p <= 'z') capScale = 0.7f;
+
+        //the glyph found for this character
+        auto glyph = glyphs[p - doc.text];
+        if (!glyph) {
+            ++p;
+            ++idx;
+            continue;
         }
 
-        //find the glyph
-        bool found = false;
-        ARRAY_FOREACH(g, text->font->chars) {
-            auto glyph = *g;
-            //draw matched glyphs
-            if (!strncmp(glyph->code, code, glyph->len)) {
-                if (textGrouping == LottieText::AlignOption::Group::Chars || textGrouping == LottieText::AlignOption::Group::All) {
-                    //new text group, single scene for each characters
-                    scene->push(textGroup);
-                    textGroup = Scene::gen();
-                    textGroup->translate(cursor.x, cursor.y);
-                }
+        if (textGrouping == LottieText::AlignOption::Group::Chars || textGrouping == LottieText::AlignOption::Group::All) {
+            //new text group, single scene for each characters
+            textGroup = _group(text, scene, textGroup, cursor);
+        }
 
-                auto& textGroupMatrix = textGroup->transform();
-                auto shape = text->pooling();
-                shape->reset();
-                ARRAY_FOREACH(p, glyph->children) {
-                    auto group = static_cast<LottieGroup*>(*p);
-                    ARRAY_FOREACH(p, group->children) {
-                        if (static_cast<LottiePath*>(*p)->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps)) {
-                            PAINT(shape)->mark(RenderUpdateFlag::Path);
-                        }
+        auto& textGroupMatrix = textGroup->transform();
+        auto shape = text->pooling();
+        shape->reset();
+        if (glyph->path) {
+            SHAPE(shape)->rs.path = *glyph->path;
+            PAINT(shape)->mark(RenderUpdateFlag::Path);
+        } else {
+            retain = false;
+            ARRAY_FOREACH(p, glyph->children) {
+                auto group = static_cast<LottieGroup*>(*p);
+                ARRAY_FOREACH(p, group->children) {
+                    if (static_cast<LottiePath*>(*p)->pathset(frameNo, SHAPE(shape)->rs.path.edit(), nullptr, tween, exps)) {
+                        PAINT(shape)->mark(RenderUpdateFlag::Path);
                     }
                 }
-                shape->fill(doc.color.rgb[0], doc.color.rgb[1], doc.color.rgb[2]);
-                shape->translate(cursor.x - textGroupMatrix.e13, cursor.y - textGroupMatrix.e23);
-                shape->opacity(255);
-
-                if (doc.stroke.width > 0.0f) {
-                    shape->strokeJoin(StrokeJoin::Round);
-                    shape->strokeWidth(doc.stroke.width / scale);
-                    shape->strokeFill(doc.stroke.color.rgb[0], doc.stroke.color.rgb[1], doc.stroke.color.rgb[2]);
+            }
+        }
+        shape->fill(doc.color.rgb[0], doc.color.rgb[1], doc.color.rgb[2]);
+        shape->translate(cursor.x - textGroupMatrix.e13, cursor.y - textGroupMatrix.e23);
+        shape->opacity(255);
+
+        if (doc.stroke.width > 0.0f) {
+            shape->strokeJoin(StrokeJoin::Round);
+            shape->strokeWidth(doc.stroke.width / scale);
+            shape->strokeFill(doc.stroke.color.rgb[0], doc.stroke.color.rgb[1], doc.stroke.color.rgb[2]);
+            shape->order(doc.stroke.below);
+        }
+
+        auto needGroup = false;
+        //text range process
+        if (!text->ranges.empty()) {
+            Point scaling = {1.0f, 1.0f};
+            auto rotation = 0.0f;
+            Point translation = {0.0f, 0.0f};
+            auto color = doc.color;
+            auto strokeColor = doc.stroke.color;
+            uint8_t opacity = 255;
+            uint8_t fillOpacity = 255;
+            uint8_t strokeOpacity = 255;
+
+            ARRAY_FOREACH(p, text->ranges) {
+                auto range = *p;
+                auto basedIdx = idx;
+                if (range->based == LottieTextRange::Based::CharsExcludingSpaces) basedIdx = idx - space;
+                else if (range->based == LottieTextRange::Based::Words) basedIdx = line + space;
+                else if (range->based == LottieTextRange::Based::Lines) basedIdx = line;
+
+                auto f = range->factor(frameNo, float(totalChars), (float)basedIdx);
+                if (tvg::zero(f)) continue;
+                needGroup = true;
+
+                translation = translation + f * range->style.position(frameNo, tween, exps);
+                scaling = scaling * (f * (range->style.scale(frameNo, tween, exps) * 0.01f - Point{1.0f, 1.0f}) + Point{1.0f, 1.0f});
+                rotation += f * range->style.rotation(frameNo, tween, exps);
+
+                opacity = (uint8_t)(opacity - f * (opacity - range->style.opacity(frameNo, tween, exps)));
+                shape->opacity(opacity);
+
+                range->color(frameNo, color, strokeColor, f, tween, exps);
+
+                fillOpacity = (uint8_t)(fillOpacity - f * (fillOpacity - range->style.fillOpacity(frameNo, tween, exps)));
+                shape->fill(color.rgb[0], color.rgb[1], color.rgb[2], fillOpacity);
+
+                if (range->style.flags.strokeWidth) shape->strokeWidth(f * range->style.strokeWidth(frameNo, tween, exps) / scale);
+                if (shape->strokeWidth() > 0.0f) {
+                    strokeOpacity = (uint8_t)(strokeOpacity - f * (strokeOpacity - range->style.strokeOpacity(frameNo, tween, exps)));
+                    shape->strokeFill(strokeColor.rgb[0], strokeColor.rgb[1], strokeColor.rgb[2], strokeOpacity);
                     shape->order(doc.stroke.below);
                 }
+                cursor.x += f * range->style.letterSpacing(frameNo, tween, exps);
 
-                auto needGroup = false;
-                //text range process
-                if (!text->ranges.empty()) {
-                    Point scaling = {1.0f, 1.0f};
-                    auto rotation = 0.0f;
-                    Point translation = {0.0f, 0.0f};
-                    auto color = doc.color;
-                    auto strokeColor = doc.stroke.color;
-                    uint8_t opacity = 255;
-                    uint8_t fillOpacity = 255;
-                    uint8_t strokeOpacity = 255;
-
-                    ARRAY_FOREACH(p, text->ranges) {
-                        auto range = *p;
-                        auto basedIdx = idx;
-                        if (range->based == LottieTextRange::Based::CharsExcludingSpaces) basedIdx = idx - space;
-                        else if (range->based == LottieTextRange::Based::Words) basedIdx = line + space;
-                        else if (range->based == LottieTextRange::Based::Lines) basedIdx = line;
-
-                        auto f = range->factor(frameNo, float(totalChars), (float)basedIdx);
-                        if (tvg::zero(f)) continue;
-                        needGroup = true;
-
-                        translation = translation + f * range->style.position(frameNo, tween, exps);
-                        scaling = scaling * (f * (range->style.scale(frameNo, tween, exps) * 0.01f - Point{1.0f, 1.0f}) + Point{1.0f, 1.0f});
-                        rotation += f * range->style.rotation(frameNo, tween, exps);
-
-                        opacity = (uint8_t)(opacity - f * (opacity - range->style.opacity(frameNo, tween, exps)));
-                        shape->opacity(opacity);
-
-                        range->color(frameNo, color, strokeColor, f, tween, exps);
-
-                        fillOpacity = (uint8_t)(fillOpacity - f * (fillOpacity - range->style.fillOpacity(frameNo, tween, exps)));
-                        shape->fill(color.rgb[0], color.rgb[1], color.rgb[2], fillOpacity);
-
-                        if (range->style.flags.strokeWidth) shape->strokeWidth(f * range->style.strokeWidth(frameNo, tween, exps) / scale);
-                        if (shape->strokeWidth() > 0.0f) {
-                            strokeOpacity = (uint8_t)(strokeOpacity - f * (strokeOpacity - range->style.strokeOpacity(frameNo, tween, exps)));
-                            shape->strokeFill(strokeColor.rgb[0], strokeColor.rgb[1], strokeColor.rgb[2], strokeOpacity);
-                            shape->order(doc.stroke.below);
-                        }
-                        cursor.x += f * range->style.letterSpacing(frameNo, tween, exps);
-
-                        auto spacing = f * range->style.lineSpacing(frameNo, tween, exps);
-                        if (spacing > lineSpacing) lineSpacing = spacing;
-                    }
-
-                    // TextGroup transformation is performed once
-                    if (textGroup->paints().size() == 0 && needGroup) {
-                        tvg::identity(&textGroupMatrix);
-                        translate(&textGroupMatrix, cursor);
-
-                        auto alignment = text->alignOption.anchor(frameNo, tween, exps);
-
-                        // center pivoting
-                        textGroupMatrix.e13 += alignment.x;
-                        textGroupMatrix.e23 += alignment.y;
+                auto spacing = f * range->style.lineSpacing(frameNo, tween, exps);
+                if (spacing > lineSpacing) lineSpacing = spacing;
+            }
 
-                        rotate(&textGroupMatrix, rotation);
+            // TextGroup transformation is performed once
+            if (textGroup->paints().size() == 0 && needGroup) {
+                tvg::identity(&textGroupMatrix);
+                translate(&textGroupMatrix, cursor);
 
-                        //center pivoting
-                        auto pivot = alignment * -1;
-                        textGroupMatrix.e13 += (pivot.x * textGroupMatrix.e11 + pivot.x * textGroupMatrix.e12);
-                        textGroupMatrix.e23 += (pivot.y * textGroupMatrix.e21 + pivot.y * textGroupMatrix.e22);
+                auto alignment = text->alignOption.anchor(frameNo, tween, exps);
 
-                        textGroup->transform(textGroupMatrix);
-                    }
+                // center pivoting
+                textGroupMatrix.e13 += alignment.x;
+                textGroupMatrix.e23 += alignment.y;
 
-                    auto& matrix = shape->transform();
-                    tvg::identity(&matrix);
-                    translate(&matrix, (translation / scale + cursor) - Point{textGroupMatrix.e13, textGroupMatrix.e23});
-                    tvg::scale(&matrix, scaling * capScale);
-                    shape->transform(matrix);
-                }
+                rotate(&textGroupMatrix, rotation);
 
-                if (needGroup) {
-                    textGroup->push(shape);
-                } else {
-                    // When text isn't selected, exclude the shape from the text group
-                    // Cases with matrix scaling factors =! 1 handled in the 'needGroup' scenario
-                    auto& matrix = shape->transform();
-
-                    if (followPath) {
-                        tvg::identity(&matrix);
-                        auto angle = 0.0f;
-                        auto halfGlyphWidth = glyph->width * 0.5f;
-                        auto position = followPath->position(cursor.x + halfGlyphWidth + firstMargin, angle);
-                        matrix.e11 = matrix.e22 = capScale;
-                        matrix.e13 = position.x - halfGlyphWidth * matrix.e11;
-                        matrix.e23 = position.y - halfGlyphWidth * matrix.e21;
-                    } else {
-                        matrix.e11 = matrix.e22 = capScale;
-                        matrix.e13 = cursor.x;
-                        matrix.e23 = cursor.y;
-                    }
+                //center pivoting
+                auto pivot = alignment * -1;
+                textGroupMatrix.e13 += (pivot.x * textGroupMatrix.e11 + pivot.x * textGroupMatrix.e12);
+                textGroupMatrix.e23 += (pivot.y * textGroupMatrix.e21 + pivot.y * textGroupMatrix.e22);
 
-                    shape->transform(matrix);
-                    scene->push(shape);
-                }
-
-                p += glyph->len;
-                idx += glyph->len;
+                textGroup->transform(textGroupMatrix);
+            }
 
-                //advance the cursor position horizontally
-                cursor.x += (glyph->width + doc.tracking) * capScale;
+            auto& matrix = shape->transform();
+            tvg::identity(&matrix);
+            translate(&matrix, (translation / scale + cursor) - Point{textGroupMatrix.e13, textGroupMatrix.e23});
+            tvg::scale(&matrix, scaling * capScale);
+            shape->transform(matrix);
+        }
 
-                found = true;
-                break;
+        if (needGroup) {
+            textGroup->push(shape);
+        } else {
+            // When text isn't selected, exclude the shape from the text group
+            // Cases with matrix scaling factors =! 1 handled in the 'needGroup' scenario
+            auto& matrix = shape->transform();
+
+            if (followPath) {
+                tvg::identity(&matrix);
+                auto angle = 0.0f;
+                auto halfGlyphWidth = glyph->width * 0.5f;
+                auto position = followPath->position(cursor.x + halfGlyphWidth + firstMargin, angle);
+                matrix.e11 = matrix.e22 = capScale;
+                matrix.e13 = position.x - halfGlyphWidth * matrix.e11;
+                matrix.e23 = position.y - halfGlyphWidth * matrix.e21;
+            } else {
+                matrix.e11 = matrix.e22 = capScale;
+                matrix.e13 = cursor.x;
+                matrix.e23 = cursor.y;
             }
-        }
 
-        if (!found) {
-            ++p;
-            ++idx;
+            shape->transform(matrix);
+            scene->push(shape);
         }
+
+        p += glyph->len;
+        idx += glyph->len;
+
+        //advance the cursor position horizontally
+        cursor.x += (glyph->width + doc.tracking) * capScale;
     }
 
-    delete(scene);
-    delete(textGroup);
+    if (retain) {
+        cache.text = body;
+        cache.revision = text->layout.revision;
+    }
 }
 
 
@@ -1170,7 +1423,7 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 
     //Introduce an intermediate scene for embracing matte + masking or precomp clipping + masking replaced by clipping
     if (layer->matteTarget || layer->type == LottieLayer::Precomp) {
-        auto scene = Scene::gen();
+        auto scene = layer->wrappers.pooling();
         scene->push(layer->scene);
         layer->scene = scene;
     }
@@ -1214,12 +1467,12 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 
         //Default Masking
         if (expand == 0.0f) {
-            mask->pathset(frameNo, SHAPE(pShape)->rs.path, nullptr, tween, exps);
+            mask->pathset(frameNo, SHAPE(pShape)->rs.path.edit(), nullptr, tween, exps);
         //Masking with Expansion (Offset)
         } else {
             //TODO: Once path direction support is implemented, ensure that the direction is ignored here
             auto offset = LottieOffsetModifier(expand);
-            mask->pathset(frameNo, SHAPE(pShape)->rs.path, nullptr, tween, exps, &offset);
+            mask->pathset(frameNo, SHAPE(pShape)->rs.path.edit(), nullptr, tween, exps, &offset);
         }
         pOpacity = opacity;
         pMethod = method;
@@ -1238,7 +1491,6 @@ bool LottieBuilder::updateMatte(LottieComposition* comp, float frameNo, Scene* s
         layer->scene->mask(target->scene, layer->matteType);
     } else if (layer->matteType == MaskMethod::Alpha || layer->matteType == MaskMethod::Luma) {
         //matte target is not exist. alpha blending definitely bring an invisible result
-        delete(layer->scene);
         layer->scene = nullptr;
         return false;
     }
@@ -1256,13 +1508,13 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
     //FIXME: all mask
     if (effect->allMask(frameNo)) {
         ARRAY_FOREACH(p, layer->masks) {
-            (*p)->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps);
+            (*p)->pathset(frameNo, SHAPE(shape)->rs.path.edit(), nullptr, tween, exps);
         }
     //A specific mask
     } else {
         auto idx = static_cast<uint32_t>(effect->mask(frameNo) - 1);
         if (idx < 0 || idx >= layer->masks.count) return;
-        layer->masks[idx]->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps);
+        layer->masks[idx]->pathset(frameNo, SHAPE(shape)->rs.path.edit(), nullptr, tween, exps);
     }
 
     shape->transform(layer->cache.matrix);
@@ -1365,8 +1617,15 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
     //full transparent scene. no need to perform
     if (layer->type != LottieLayer::Null && layer->cache.opacity == 0) return;
 
+    //the constant layer keeps the scene built at the first visible frame
+    if (layer->cache.scene) {
+        layer->scene = layer->cache.scene;
+        if (scene && !layer->matteSrc) scene->push(layer->scene);
+        return;
+    }
+
     //Prepare render data
-    layer->scene = Scene::gen();
+    layer->scene = layer->scenes.pooling();
     layer->scene->id = layer->id;
 
     //ignore opacity when Null layer?
@@ -1378,6 +1637,7 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
 
     switch (layer->type) {
         case LottieLayer::Precomp: {
+            if (freezing && layer->frozen && updateFrozen(comp, layer, frameNo)) break;
             if (!tweening()) updatePrecomp(comp, layer, frameNo);
             else updatePrecomp(comp, layer, frameNo, tween);
             break;
@@ -1411,7 +1671,319 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
 
     updateEffect(layer, frameNo);
 
-    if (!layer->matteSrc) scene->push(layer->scene);
+    if (layer->constant && !tweening()) layer->cache.scene = layer->scene;
+
+    //the scene is pushed by the caller if no parent scene is given
+    if (scene && !layer->matteSrc) scene->push(layer->scene);
+}
+
+
+/* Detach the layer scenes from the previous frame tree. The scenes and their paints are
+   retained and reassigned with the next frame properties so that the renderer could
+   regenerate the changed render data only. */
+static void _release(LottieLayer* layer, bool retain)
+{
+    //keep the constant layer scene tree as it is
+    if (retain && layer->cache.scene) return;
+    layer->cache.scene = nullptr;
+
+    auto release = [](Array<Scene*>& scenes) {
+        ARRAY_FOREACH(p, scenes) {
+            auto scene = *p;
+            scene->remove();
+            scene->clip(nullptr);
+            scene->mask(nullptr, MaskMethod::None);
+            scene->push(SceneEffect::ClearAll);
+        }
+    };
+
+    release(layer->scenes.pooler);
+    release(layer->wrappers.pooler);
+
+    //the intermediate scenes take the mask opacity
+    ARRAY_FOREACH(p, layer->wrappers.pooler) (*p)->opacity(255);
+
+    if (layer->type != LottieLayer::Precomp) return;
+
+    ARRAY_FOREACH(p, layer->children) _release(static_cast<LottieLayer*>(*p), retain);
+}
+
+
+static bool _constant(LottieTransform* transform, float begin, float end)
+{
+    if (!transform) return true;
+
+    if (!transform->position.constant(begin, end) || !transform->rotation.constant(begin, end) || !transform->scale.constant(begin, end)) return false;
+    if (!transform->anchor.constant(begin, end) || !transform->opacity.constant(begin, end)) return false;
+    if (!transform->skewAngle.constant(begin, end) || !transform->skewAxis.constant(begin, end)) return false;
+    if (auto coords = transform->coords) {
+        if (!coords->x.constant(begin, end) || !coords->y.constant(begin, end)) return false;
+    }
+    if (auto rotationEx = transform->rotationEx) {
+        if (!rotationEx->x.constant(begin, end) || !rotationEx->y.constant(begin, end)) return false;
+    }
+    return true;
+}
+
+
+static bool _constant(LottieStroke* stroke, float begin, float end)
+{
+    if (!stroke->width.constant(begin, end)) return false;
+    if (auto dashattr = stroke->dashattr) {
+        if (!dashattr->offset.constant(begin, end)) return false;
+        for (uint8_t i = 0; i < dashattr->size; ++i) {
+            if (!dashattr->values[i].constant(begin, end)) return false;
+        }
+    }
+    return true;
+}
+
+
+static bool _constant(LottieGradient* gradient, float begin, float end)
+{
+    if (!gradient->start.constant(begin, end) || !gradient->end.constant(begin, end) || !gradient->height.constant(begin, end)) return false;
+    return gradient->angle.constant(begin, end) && gradient->opacity.constant(begin, end) && gradient->colorStops.constant(begin, end);
+}
+
+
+static bool _constant(LottieObject* obj, float begin, float end)
+{
+    switch (obj->type) {
+        case LottieObject::Group: {
+            ARRAY_FOREACH(p, static_cast<LottieGroup*>(obj)->children) {
+                if (!_constant(*p, begin, end)) return false;
+            }
+            return true;
+        }
+        case LottieObject::Transform: {
+            return _constant(static_cast<LottieTransform*>(obj), begin, end);
+        }
+        case LottieObject::SolidFill: {
+            auto fill = static_cast<LottieSolidFill*>(obj);
+            return fill->color.constant(begin, end) && fill->opacity.constant(begin, end);
+        }
+        case LottieObject::SolidStroke: {
+            auto stroke = static_cast<LottieSolidStroke*>(obj);
+            return stroke->color.constant(begin, end) && stroke->opacity.constant(begin, end) && _constant(static_cast<LottieStroke*>(stroke), begin, end);
+        }
+        case LottieObject::GradientFill: {
+            return _constant(static_cast<LottieGradient*>(static_cast<LottieGradientFill*>(obj)), begin, end);
+        }
+        case LottieObject::GradientStroke: {
+            auto stroke = static_cast<LottieGradientStroke*>(obj);
+            return _constant(static_cast<LottieGradient*>(stroke), begin, end) && _constant(static_cast<LottieStroke*>(stroke), begin, end);
+        }
+        case LottieObject::Rect: {
+            auto rect = static_cast<LottieRect*>(obj);
+            return rect->position.constant(begin, end) && rect->size.constant(begin, end) && rect->radius.constant(begin, end);
+        }
+        case LottieObject::Ellipse: {
+            auto ellipse = static_cast<LottieEllipse*>(obj);
+            return ellipse->position.constant(begin, end) && ellipse->size.constant(begin, end);
+        }
+        case LottieObject::Path: {
+            return static_cast<LottiePath*>(obj)->pathset.constant(begin, end);
+        }
+        case LottieObject::Polystar: {
+            auto star = static_cast<LottiePolyStar*>(obj);
+            if (!star->position.constant(begin, end) || !star->rotation.constant(begin, end) || !star->ptsCnt.constant(begin, end)) return false;
+            if (!star->innerRadius.constant(begin, end) || !star->outerRadius.constant(begin, end)) return false;
+            return star->innerRoundness.constant(begin, end) && star->outerRoundness.constant(begin, end);
+        }
+        case LottieObject::Trimpath: {
+            auto trimpath = static_cast<LottieTrimpath*>(obj);
+            return trimpath->start.constant(begin, end) && trimpath->end.constant(begin, end) && trimpath->offset.constant(begin, end);
+        }
+        case LottieObject::Repeater: {
+            auto repeater = static_cast<LottieRepeater*>(obj);
+            if (!repeater->copies.constant(begin, end) || !repeater->offset.constant(begin, end)) return false;
+            if (!repeater->position.constant(begin, end) || !repeater->rotation.constant(begin, end)) return false;
+            if (!repeater->scale.constant(begin, end) || !repeater->anchor.constant(begin, end)) return false;
+            return repeater->startOpacity.constant(begin, end) && repeater->endOpacity.constant(begin, end);
+        }
+        case LottieObject::RoundedCorner: {
+            return static_cast<LottieRoundedCorner*>(obj)->radius.constant(begin, end);
+        }
+        case LottieObject::OffsetPath: {
+            auto offset = static_cast<LottieOffsetPath*>(obj);
+            return offset->offset.constant(begin, end) && offset->miterLimit.constant(begin, end);
+        }
+        case LottieObject::Image: return true;
+        default: return false;
+    }
+}
+
+
+static bool _constant(LottieEffect* effect, float begin, float end)
+{
+    switch (effect->type) {
+        case LottieEffect::Custom: {
+            ARRAY_FOREACH(p, static_cast<LottieFxCustom*>(effect)->props) {
+                if (!p->property->constant(begin, end)) return false;
+            }
+            return true;
+        }
+        case LottieEffect::Tint: {
+            auto fx = static_cast<LottieFxTint*>(effect);
+            return fx->black.constant(begin, end) && fx->white.constant(begin, end) && fx->intensity.constant(begin, end);
+        }
+        case LottieEffect::Fill: {
+            auto fx = static_cast<LottieFxFill*>(effect);
+            return fx->color.constant(begin, end) && fx->opacity.constant(begin, end);
+        }
+        case LottieEffect::Stroke: {
+            auto fx = static_cast<LottieFxStroke*>(effect);
+            if (!fx->mask.constant(begin, end) || !fx->allMask.constant(begin, end) || !fx->color.constant(begin, end)) return false;
+            if (!fx->size.constant(begin, end) || !fx->opacity.constant(begin, end)) return false;
+            return fx->begin.constant(begin, end) && fx->end.constant(begin, end);
+        }
+        case LottieEffect::Tritone: {
+            auto fx = static_cast<LottieFxTritone*>(effect);
+            return fx->bright.constant(begin, end) && fx->midtone.constant(begin, end) && fx->dark.constant(begin, end);
+        }
+        case LottieEffect::DropShadow: {
+            auto fx = static_cast<LottieFxDropShadow*>(effect);
+            if (!fx->color.constant(begin, end) || !fx->opacity.constant(begin, end) || !fx->angle.constant(begin, end)) return false;
+            return fx->distance.constant(begin, end) && fx->blurness.constant(begin, end);
+        }
+        case LottieEffect::GaussianBlur: {
+            auto fx = static_cast<LottieFxGaussianBlur*>(effect);
+            return fx->blurness.constant(begin, end) && fx->direction.constant(begin, end) && fx->wrap.constant(begin, end);
+        }
+        default: return false;
+    }
+}
+
+
+//the layer is visible either for the whole frame range [begin, end) or not at all
+static bool _steady(LottieLayer* layer, float begin, float end)
+{
+    if (layer->outFrame <= begin || layer->inFrame >= end) return true;
+    return layer->inFrame <= begin && layer->outFrame >= end;
+}
+
+
+//the frozen precomp contents are drawn with the outer raster
+static void _thaw(LottieLayer* layer)
+{
+    layer->frozen = false;
+    layer->cache.release();
+    if (layer->type != LottieLayer::Precomp) return;
+    ARRAY_FOREACH(p, layer->children) _thaw(static_cast<LottieLayer*>(*p));
+}
+
+
+/* Figure out the layers whose contents don't change in their active frame range.
+   Those layers are built once and their scenes are reused in the following frames.
+   The layers of the shared assets can't be retained since they are built per precomp. */
+static bool _analyze(LottieLayer* layer, bool shared)
+{
+    auto begin = layer->inFrame;
+    auto end = layer->outFrame;
+    auto ret = true;
+    auto frozen = true;         //the precomp contents only
+    auto rasterizable = true;
+
+    shared |= layer->shared;
+
+    //transform with the parents
+    for (auto p = layer; p; p = p->parent) {
+        if (!_constant(p->transform, begin, end)) {
+            ret = false;
+            break;
+        }
+    }
+
+    ARRAY_FOREACH(p, layer->masks) {
+        auto mask = *p;
+        if (!mask->pathset.constant(begin, end) || !mask->expand.constant(begin, end) || !mask->opacity.constant(begin, end)) ret = false;
+    }
+
+    ARRAY_FOREACH(p, layer->effects) {
+        if ((*p)->enable && !_constant(*p, begin, end)) ret = false;
+    }
+
+    if (auto target = layer->matteTarget) {
+        if (!_analyze(target, shared) || !_steady(target, begin, end)) ret = false;
+    }
+
+    switch (layer->type) {
+        case LottieLayer::Precomp: {
+            //the constant time remapping freezes the children at a frame
+            auto remapped = layer->timeRemap.frames || layer->timeRemap.value >= 0.0f;
+            if (remapped && !layer->timeRemap.constant(begin, end)) frozen = false;
+            //the deferred layers are not known yet
+            if (layer->deferred) frozen = false;
+            auto rbegin = (begin - layer->startFrame) / layer->timeStretch;
+            auto rend = (end - layer->startFrame) / layer->timeStretch;
+            if (rbegin > rend) std::swap(rbegin, rend);
+            ARRAY_FOREACH(p, layer->children) {
+                auto child = static_cast<LottieLayer*>(*p);
+                if (!_analyze(child, shared)) frozen = false;
+                else if (!remapped && !_steady(child, rbegin, rend)) frozen = false;
+                //blending with the backdrop of the precomp, it can't be rendered alone
+                if (child->blendMethod != BlendMethod::Normal) rasterizable = false;
+            }
+            if (!frozen) ret = false;
+            break;
+        }
+        case LottieLayer::Text: {
+            ret = false;
+            break;
+        }
+        default: {
+            ARRAY_FOREACH(p, layer->children) {
+                if (!_constant(*p, begin, end)) {
+                    ret = false;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    layer->constant = ret && !shared;
+    layer->steady = layer->type == LottieLayer::Precomp && frozen;
+
+    //the contents are frozen while its transform or the others are changing
+    layer->frozen = layer->type == LottieLayer::Precomp && frozen && rasterizable && !ret && !shared;
+    if (layer->frozen) {
+        ARRAY_FOREACH(p, layer->children) _thaw(static_cast<LottieLayer*>(*p));
+    }
+    layer->cache.release();
+
+    return ret;
+}
+
+
+//the layer tree doesn't touch the resources shared with the other layers,
+//the frozen precomps are rasterized with the shared precomp instances of the builder
+static bool _isolated(LottieLayer* layer, bool freezing)
+{
+    if (layer->shared || layer->deferred || layer->type == LottieLayer::Text || layer->type == LottieLayer::Image) return false;
+
+    if (layer->type == LottieLayer::Precomp) {
+        if (freezing && layer->frozen) return false;
+        ARRAY_FOREACH(p, layer->children) {
+            if (!_isolated(static_cast<LottieLayer*>(*p), freezing)) return false;
+        }
+    }
+    return true;
+}
+
+
+/* Figure out the root layers which could be built independently from the others.
+   The parenting and the matting link the layers to each other, so those are excluded. */
+static void _isolate(LottieLayer* root, bool freezing)
+{
+    ARRAY_FOREACH(p, root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        layer->isolated = !layer->parent && !layer->matteSrc && !layer->matteTarget && _isolated(layer, freezing);
+    }
+
+    ARRAY_FOREACH(p, root->children) {
+        if (auto parent = static_cast<LottieLayer*>(*p)->parent) parent->isolated = false;
+    }
 }
 
 
@@ -1421,6 +1993,16 @@ static void _buildReference(LottieComposition* comp, LottieLayer* layer)
         if (layer->rid != (*p)->id) continue;
         if (layer->type == LottieLayer::Precomp) {
             auto assetLayer = static_cast<LottieLayer*>(*p);
+            //the asset layers are not parsed yet, attach them when this precomp shows up
+            if (auto deferral = comp->deferral(assetLayer)) {
+                if (++deferral->refs > 1) assetLayer->shared = true;
+                layer->deferred = true;
+                break;
+            }
+            //the asset layers are referenced by another precomp already
+            if (assetLayer->shared || (assetLayer->buildDone && layer->children.empty())) {
+                ARRAY_FOREACH(c, assetLayer->children) static_cast<LottieLayer*>(*c)->shared = true;
+            }
             if (_buildComposition(comp, assetLayer)) {
                 layer->children = assetLayer->children;
                 layer->reqFragment = assetLayer->reqFragment;
@@ -1433,6 +2015,19 @@ static void _buildReference(LottieComposition* comp, LottieLayer* layer)
 }
 
 
+//parse the deferred asset layers and attach them to the precomp
+static bool _resolve(LottieComposition* comp, LottieLayer* precomp)
+{
+    precomp->deferred = false;
+    //the asset could be parsed by another precomp already
+    auto asset = comp->asset(precomp->rid);
+    if (comp->deferral(asset) && !comp->inflate(asset)) return false;
+    _buildReference(comp, precomp);
+    ++comp->revision;
+    return true;
+}
+
+
 static void _buildHierarchy(LottieGroup* parent, LottieLayer* child)
 {
     if (child->pix == -1) return;
@@ -1515,11 +2110,107 @@ static bool _buildComposition(LottieComposition* comp, LottieLayer* parent)
 }
 
 
+#ifdef THORVG_THREAD_SUPPORT
+
+void LottieLayerTask::run(TVG_UNUSED unsigned tid)
+{
+    builder->process(batch);
+    batch->unref();
+    batch = nullptr;
+    busy = false;
+}
+
+
+void LottieBuilder::process(LottieLayerBatch* batch)
+{
+    uint32_t idx;
+    while ((idx = batch->next++) < batch->layers.count) {
+        updateLayer(batch->comp, nullptr, batch->layers[idx], batch->frameNo);
+        lock_guard<mutex> lock(batch->mtx);
+        if (++batch->finished == batch->layers.count) batch->cv.notify_one();
+    }
+}
+
+
+/* Build the isolated root layers on the workers while this thread builds the others.
+   This thread claims the layers as well, it waits only for the ones in progress,
+   so the workers busy with the other tasks never block the frame update.
+   The tweening shares the builder states, the expressions share the engine,
+   so those are built in order. */
+bool LottieBuilder::concurrent(LottieComposition* comp, float frameNo)
+{
+    auto threads = TaskScheduler::threads();
+    if (threads == 0 || tweening() || (exps && comp->expressions)) return false;
+
+    auto root = comp->root;
+    auto batch = new LottieLayerBatch;
+    auto cnt = 0;
+
+    ARRAY_REVERSE_FOREACH(p, root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (!layer->isolated) continue;
+        batch->layers.push(layer);
+        if (!layer->cache.scene && frameNo >= layer->inFrame && frameNo < layer->outFrame) ++cnt;
+    }
+
+    //not worth it
+    if (cnt < 2) {
+        delete(batch);
+        return false;
+    }
+
+    batch->comp = comp;
+    batch->frameNo = frameNo;
+
+    if (tasks.count < threads) {
+        tasks.reserve(threads);
+        while (tasks.count < threads) tasks.push(new LottieLayerTask(this));
+    }
+
+    //request the idle workers, the others are still draining the former batches
+    auto requests = std::min(threads, uint32_t(cnt - 1));
+    ARRAY_FOREACH(p, tasks) {
+        if (requests == 0) break;
+        auto task = *p;
+        if (task->busy) continue;
+        task->done();
+        task->busy = true;
+        task->batch = batch;
+        ++batch->refCnt;
+        TaskScheduler::request(task);
+        --requests;
+    }
+
+    ARRAY_REVERSE_FOREACH(p, root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (!layer->matteSrc && !layer->isolated) updateLayer(comp, nullptr, layer, frameNo);
+    }
+
+    process(batch);
+
+    {
+        unique_lock<mutex> lock(batch->mtx);
+        while (batch->finished < batch->layers.count) batch->cv.wait(lock);
+    }
+    batch->unref();
+
+    //keep the layer order
+    ARRAY_REVERSE_FOREACH(p, root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        if (!layer->matteSrc && layer->scene) root->scene->push(layer->scene);
+    }
+
+    return true;
+}
+
+#endif //THORVG_THREAD_SUPPORT
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
-bool LottieBuilder::update(LottieComposition* comp, float frameNo)
+bool LottieBuilder::update(LottieComposition* comp, float frameNo, bool instancing)
 {
     if (comp->root->children.empty()) return false;
 
@@ -1535,7 +2226,33 @@ bool LottieBuilder::update(LottieComposition* comp, float frameNo)
     auto root = comp->root;
     root->scene->remove();
 
-    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo));
+    //the layer tree has been changed by attaching the deferred assets
+    if (revision != comp->revision) {
+        revision = comp->revision;
+        analyzed = false;
+    }
+
+    auto retain = analyzed && !tweening();
+    ARRAY_FOREACH(p, root->children) _release(static_cast<LottieLayer*>(*p), retain);
+
+    if (!analyzed) {
+        ARRAY_FOREACH(p, root->children) _analyze(static_cast<LottieLayer*>(*p), false);
+        _isolate(root, freezing);
+        analyzed = true;
+    }
+
+    if (comp->expressions) {
+        if (!exps) exps = LottieExpressions::instance();
+        if (exps) exps->update(comp->timeAtFrame(frameNo));
+    }
+
+    ARRAY_FOREACH(p, root->children) static_cast<LottieLayer*>(*p)->cache.scale = scale;
+    instances.clear();
+    this->instancing = instancing;
+
+#ifdef THORVG_THREAD_SUPPORT
+    if (concurrent(comp, frameNo)) return true;
+#endif
 
     ARRAY_REVERSE_FOREACH(child, root->children) {
         auto layer = static_cast<LottieLayer*>(*child);
@@ -1554,7 +2271,7 @@ void LottieBuilder::build(LottieComposition* comp)
 
     _buildComposition(comp, comp->root);
 
-    if (!update(comp, 0)) return;
+    if (!update(comp, 0, false)) return;
 
     //viewport clip
     auto clip = Shape::gen();
@@ -26,10 +26,13 @@
 #include "tvgCommon.h"
 #include "tvgInlist.h"
 #include "tvgShape.h"
+#include "tvgTaskScheduler.h"
 #include "tvgLottieExpressions.h"
 #include "tvgLottieModifier.h"
 
 struct LottieComposition;
+struct LottieLayer;
+struct LottieBuilder;
 
 struct RenderRepeater
 {
@@ -104,21 +107,68 @@ struct RenderContext
     }
 };
 
-struct LottieBuilder
+//the contents of a shared precomp asset built in the frame, the other references at the same time copy them
+struct LottieInstance
 {
-    LottieBuilder()
+    LottieObject* asset;   //the first child layer of the asset
+    float frameNo;
+    float scale;
+    Scene* scene;
+};
+
+#ifdef THORVG_THREAD_SUPPORT
+
+//the isolated layers of a frame, claimed one by one by the builder and the workers
+struct LottieLayerBatch
+{
+    Array<LottieLayer*> layers;
+    LottieComposition* comp;
+    float frameNo;
+    atomic<uint32_t> next{0};      //index of the layer to be claimed
+    atomic<uint32_t> refCnt{1};
+    uint32_t finished = 0;
+    mutex mtx;
+    condition_variable cv;
+
+    void unref()
     {
-        exps = LottieExpressions::instance();
+        if (--refCnt == 0) delete(this);
     }
+};
+
+
+struct LottieLayerTask : Task
+{
+    LottieBuilder* builder;
+    LottieLayerBatch* batch = nullptr;
+    atomic<bool> busy{false};      //requested but not finished yet
+
+    LottieLayerTask(LottieBuilder* builder) : builder(builder) {}
+
+protected:
+    void run(unsigned tid) override;
+};
+
+#endif //THORVG_THREAD_SUPPORT
 
+
+struct LottieBuilder
+{
     ~LottieBuilder()
     {
+#ifdef THORVG_THREAD_SUPPORT
+        //the workers of the former batches might be still in the queue
+        ARRAY_FOREACH(p, tasks) {
+            (*p)->done();
+            delete(*p);
+        }
+#endif
         LottieExpressions::retrieve(exps);
     }
 
     bool expressions()
     {
-        return exps ? true : false;
+        return LottieExpressions::supported();
     }
 
     void offTween()
@@ -138,9 +188,23 @@ struct LottieBuilder
         return tween.active;
     }
 
-    bool update(LottieComposition* comp, float progress);
+    //the overridden properties require the constant layers to be analyzed again
+    void invalidate()
+    {
+        analyzed = false;
+    }
+
+    //the scale of the composition to the canvas, the frozen precomps are rasterized with it
+    void resize(float scale)
+    {
+        this->scale = scale;
+    }
+
+    bool update(LottieComposition* comp, float progress, bool instancing);
     void build(LottieComposition* comp);
 
+    bool freezing = false;     //the frozen precomps are drawn with their rasters
+
 private:
     void appendRect(Shape* shape, Point& pos, Point& size, float r, bool clockwise, RenderContext* ctx);
     bool fragmented(LottieGroup* parent, LottieObject** child, Inlist<RenderContext>& contexts, RenderContext* ctx, RenderFragment fragment);
@@ -151,6 +215,8 @@ private:
     bool updateMatte(LottieComposition* comp, float frameNo, Scene* scene, LottieLayer* layer);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo, Tween& tween);
+    bool updateFrozen(LottieComposition* comp, LottieLayer* precomp, float frameNo);
+    bool updateInstance(LottieLayer* precomp, float frameNo, float scale);
     void updateSolid(LottieLayer* layer);
     void updateImage(LottieGroup* layer);
     void updateText(LottieLayer* layer, float frameNo);
@@ -174,9 +240,21 @@ private:
     void updateRoundedCorner(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& contexts, RenderContext* ctx);
     void updateOffsetPath(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& contexts, RenderContext* ctx);
 
-    RenderPath buffer;   //resusable path
-    LottieExpressions* exps;
+    LottieExpressions* exps = nullptr;  //prepared on demand, for the expressions animation
     Tween tween;
+    Array<LottieInstance> instances;    //the shared precomp contents built in this frame
+    uint32_t revision = 0;     //the composition revision of the analysis
+    float scale = 1.0f;
+    bool analyzed = false;
+    bool instancing = false;   //the repeaters are drawn by the shape instances
+
+#ifdef THORVG_THREAD_SUPPORT
+    bool concurrent(LottieComposition* comp, float frameNo);
+    void process(LottieLayerBatch* batch);
+
+    Array<LottieLayerTask*> tasks;
+    friend struct LottieLayerTask;
+#endif
 };
 
 #endif //_TVG_LOTTIE_BUILDER_H
\ No newline at end of file
@@ -28,6 +28,9 @@
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
+#include "jerry-config.h"
+#include "jerryscript-port.h"
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -59,8 +62,6 @@ static const char* EXP_VALUE = "value";
 static const char* EXP_INDEX = "index";
 static const char* EXP_EFFECT= "effect";
 
-static LottieExpressions* exps = nullptr;   //singleton instance engine
-
 
 static ExpContent* _expcontent(LottieExpression* exp, float frameNo, void* obj, size_t refCnt = 1)
 {
@@ -149,7 +150,7 @@ static void contentFree(void *native_p, struct jerry_object_native_info_t *info_
 }
 
 static jerry_object_native_info_t freeCb {contentFree, 0, 0};
-static uint32_t engineRefCnt = 0;  //Expressions Engine reference count
+static constexpr uint32_t SCRIPT_BUDGET = 128 * 1024;  //compiled scripts in the engine heap, estimated by the code length
 
 
 static char* _name(jerry_value_t args)
@@ -1379,10 +1380,31 @@ void LottieExpressions::buildWritables(LottieExpression* exp)
 }
 
 
+bool LottieExpressions::compile(LottieExpression* exp)
+{
+    //the engine heap is limited, the others are parsed at every evaluation
+    auto len = strlen(exp->code);
+    if (scriptSize + len > SCRIPT_BUDGET) return false;
+
+    auto script = jerry_parse((jerry_char_t *) exp->code, len);
+    if (jerry_value_is_exception(script)) {
+        jerry_value_free(script);
+        return false;
+    }
+
+    exp->engine = this;
+    exp->script = script;
+    scriptSize += len;
+    return true;
+}
+
+
 jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
 {
     if (exp->disabled && exp->writables.empty()) return jerry_undefined();
 
+    jerry_port_context_p = context;
+
     buildGlobal(frameNo, exp);
 
     //main composition
@@ -1408,8 +1430,10 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
     //update writable values
     buildWritables(exp);
 
-    //evaluate the code
-    auto eval = jerry_eval((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+    //evaluate the code, parsed once if the budget allows
+    jerry_value_t eval;
+    if (exp->script || compile(exp)) eval = jerry_run(exp->script);
+    else eval = jerry_eval((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
 
     if (jerry_value_is_exception(eval)) {
         TVGERR("LOTTIE", "Failed to dispatch the expressions!");
@@ -1423,12 +1447,37 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
 }
 
 
+/************************************************************************/
+/* JerryScript Port Implementation                                      */
+/************************************************************************/
+
+//the engine context in use by the calling thread
+thread_local jerry_context_t* jerry_port_context_p = nullptr;
+
+
+size_t jerry_port_context_alloc(size_t size)
+{
+    //the engine heap follows the context
+    auto total = size + JERRY_GLOBAL_HEAP_SIZE * 1024;
+    jerry_port_context_p = tvg::malloc<jerry_context_t*>(total);
+    return total;
+}
+
+
+void jerry_port_context_free()
+{
+    tvg::free(jerry_port_context_p);
+    jerry_port_context_p = nullptr;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
 LottieExpressions::~LottieExpressions()
 {
+    jerry_port_context_p = context;
     jerry_value_free(thisProperty);
     jerry_value_free(thisLayer);
     jerry_value_free(thisComp);
@@ -1441,12 +1490,15 @@ LottieExpressions::~LottieExpressions()
 LottieExpressions::LottieExpressions()
 {
     jerry_init(JERRY_INIT_EMPTY);
+    context = jerry_port_context_p;
     _buildMath(buildGlobal());
 }
 
 
 void LottieExpressions::update(float curTime)
 {
+    jerry_port_context_p = context;
+
     //time, #current time in seconds
     auto time = jerry_number(curTime);
     jerry_object_set_sz(global, EXP_TIME, time);
@@ -1454,29 +1506,27 @@ void LottieExpressions::update(float curTime)
 }
 
 
-//FIXME: Threads support
-#include "tvgTaskScheduler.h"
-
 LottieExpressions* LottieExpressions::instance()
 {
-    //FIXME: Threads support
-    if (TaskScheduler::threads() > 1) {
-        TVGLOG("LOTTIE", "Lottie Expressions are not supported with tvg threads");
-        return nullptr;
-    }
-
-    if (!exps) exps = new LottieExpressions;
-    ++engineRefCnt;
-    return exps;
+    return new LottieExpressions;
 }
 
 
 void LottieExpressions::retrieve(LottieExpressions* instance)
 {
-    if (--engineRefCnt == 0) {
-        delete(instance);
-        exps = nullptr;
-    }
+    delete(instance);
+}
+
+
+void LottieExpressions::discard(LottieExpression* exp)
+{
+    if (!exp->script) return;
+    auto engine = exp->engine;
+    jerry_port_context_p = engine->context;
+    jerry_value_free(exp->script);
+    engine->scriptSize -= strlen(exp->code);
+    exp->script = 0;
+    exp->engine = nullptr;
 }
 
 
@@ -127,14 +127,17 @@ public:
 
     void update(float curTime);
 
-    //singleton (no thread safety)
+    //an isolated engine per instance, the instances could run on the threads independently.
     static LottieExpressions* instance();
     static void retrieve(LottieExpressions* instance);
+    static void discard(LottieExpression* exp);
+    static bool supported() { return true; }
 
 private:
     LottieExpressions();
     ~LottieExpressions();
 
+    bool compile(LottieExpression* exp);
     jerry_value_t evaluate(float frameNo, LottieExpression* exp);
     jerry_value_t buildGlobal();
 
@@ -152,6 +155,8 @@ private:
     jerry_value_t thisComp;
     jerry_value_t thisLayer;
     jerry_value_t thisProperty;
+    jerry_context_t* context;  //engine context and heap, bound to the calling thread on use
+    uint32_t scriptSize = 0;  //code length of the compiled scripts
 };
 
 #else
@@ -167,6 +172,8 @@ struct LottieExpressions
     void update(TVG_UNUSED float) {}
     static LottieExpressions* instance() { return nullptr; }
     static void retrieve(TVG_UNUSED LottieExpressions* instance) {}
+    static void discard(TVG_UNUSED LottieExpression* exp) {}
+    static bool supported() { return false; }
 };
 
 #endif //THORVG_LOTTIE_EXPRESSIONS_SUPPORT
@@ -35,8 +35,9 @@
 
 #define NEWTON_MIN_SLOPE 0.02f
 #define NEWTON_ITERATIONS 4
+#define NEWTON_PRECISION 0.000001f
 #define SUBDIVISION_PRECISION 0.0000001f
-#define SUBDIVISION_MAX_ITERATIONS 10
+#define SUBDIVISION_MAX_ITERATIONS 24
 
 
 static inline float _constA(float aA1, float aA2) { return 1.0f - 3.0f * aA2 + 3.0f * aA1; }
@@ -58,28 +59,27 @@ static inline float _calcBezier(float t, float aA1, float aA2)
 
 float LottieInterpolator::getTForX(float aX)
 {
-    //Find interval where t lies
-    auto intervalStart = 0.0f;
-    auto currentSample = &samples[1];
-    auto lastSample = &samples[SPLINE_TABLE_SIZE - 1];
-
-    for (; currentSample != lastSample && *currentSample <= aX; ++currentSample) {
-        intervalStart += SAMPLE_STEP_SIZE;
+    //Index the interval where t lies and interpolate an initial guess for t
+    auto pos = aX * float(SPLINE_TABLE_SIZE - 1);
+    if (pos <= 0.0f) return samples[0];
+    auto idx = int(pos);
+    if (idx >= SPLINE_TABLE_SIZE - 1) return samples[SPLINE_TABLE_SIZE - 1];
+
+    auto intervalStart = samples[idx];
+    auto intervalEnd = samples[idx + 1];
+    auto guessForT = intervalStart + (pos - float(idx)) * (intervalEnd - intervalStart);
+
+    // The table is dense enough that Newton-Raphson converges within a step or two.
+    // If the slope is too small or the guess leaves the interval, bisection is used instead.
+    for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
+        auto currentX = _calcBezier(guessForT, outTangent.x, inTangent.x) - aX;
+        if (fabsf(currentX) <= NEWTON_PRECISION) return guessForT;
+        auto currentSlope = _getSlope(guessForT, outTangent.x, inTangent.x);
+        if (currentSlope < NEWTON_MIN_SLOPE) break;
+        guessForT -= currentX / currentSlope;
+        if (guessForT < intervalStart || guessForT > intervalEnd) break;
     }
-
-    --currentSample;  // t now lies between *currentSample and *currentSample+1
-
-    // Interpolate to provide an initial guess for t
-    auto dist = (aX - *currentSample) / (*(currentSample + 1) - *currentSample);
-    auto guessForT = intervalStart + dist * SAMPLE_STEP_SIZE;
-
-    // Check the slope to see what strategy to use. If the slope is too small
-    // Newton-Raphson iteration won't converge on a root so we use bisection
-    // instead.
-    auto initialSlope = _getSlope(guessForT, outTangent.x, inTangent.x);
-    if (initialSlope >= NEWTON_MIN_SLOPE) return NewtonRaphsonIterate(aX, guessForT);
-    else if (initialSlope == 0.0f) return guessForT;
-    else return binarySubdivide(aX, intervalStart, intervalStart + SAMPLE_STEP_SIZE);
+    return binarySubdivide(aX, intervalStart, intervalEnd);
 }
 
 
@@ -98,21 +98,6 @@ float LottieInterpolator::binarySubdivide(float aX, float aA, float aB)
 }
 
 
-float LottieInterpolator::NewtonRaphsonIterate(float aX, float aGuessT)
-{
-    // Refine guess with Newton-Raphson iteration
-    for (int i = 0; i < NEWTON_ITERATIONS; ++i) {
-        // We're trying to find where f(t) = aX,
-        // so we're actually looking for a root for: CalcBezier(t) - aX
-        auto currentX = _calcBezier(aGuessT, outTangent.x, inTangent.x) - aX;
-        auto currentSlope = _getSlope(aGuessT, outTangent.x, inTangent.x);
-        if (currentSlope == 0.0f) return aGuessT;
-        aGuessT -= currentX / currentSlope;
-    }
-    return aGuessT;
-}
-
-
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -132,8 +117,10 @@ void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangen
 
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return;
 
-    //calculates sample values
-    for (int i = 0; i < SPLINE_TABLE_SIZE; ++i) {
-        samples[i] = _calcBezier(float(i) * SAMPLE_STEP_SIZE, outTangent.x, inTangent.x);
+    //tabulates t for the evenly spaced x, so that the progress lookup takes constant time
+    samples[0] = 0.0f;
+    samples[SPLINE_TABLE_SIZE - 1] = 1.0f;
+    for (int i = 1; i < SPLINE_TABLE_SIZE - 1; ++i) {
+        samples[i] = binarySubdivide(float(i) * SAMPLE_STEP_SIZE, samples[i - 1], 1.0f);
     }
 }
\ No newline at end of file
@@ -23,7 +23,7 @@
 #ifndef _TVG_LOTTIE_INTERPOLATOR_H_
 #define _TVG_LOTTIE_INTERPOLATOR_H_
 
-#define SPLINE_TABLE_SIZE 11
+#define SPLINE_TABLE_SIZE 65
 
 struct LottieInterpolator
 {
@@ -35,11 +35,10 @@ struct LottieInterpolator
 
 private:
     static constexpr float SAMPLE_STEP_SIZE = 1.0f / float(SPLINE_TABLE_SIZE - 1);
-    float samples[SPLINE_TABLE_SIZE];
+    float samples[SPLINE_TABLE_SIZE];  //curve parameter t at the evenly spaced x
 
     float getTForX(float aX);
     float binarySubdivide(float aX, float aA, float aB);
-    float NewtonRaphsonIterate(float aX, float aGuessT);
 };
 
 #endif //_TVG_LOTTIE_INTERPOLATOR_H_
\ No newline at end of file
@@ -30,24 +30,159 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+//the compositions shared by the animations loading the same file
+static Array<LottieComposition*> _shared;
+static Key _key;
+
+
+#ifdef THORVG_FILE_IO_SUPPORT
+static LottieComposition* _share(const char* path)
+{
+    ScopedLock lock(_key);
+    ARRAY_FOREACH(p, _shared) {
+        if (!strcmp((*p)->path, path)) {
+            ++(*p)->sharing;
+            return *p;
+        }
+    }
+    return nullptr;
+}
+#endif
+
+
+//return true if no animations share the composition anymore
+static bool _unshare(LottieComposition* comp)
+{
+    ScopedLock lock(_key);
+    if (--comp->sharing > 0) return false;
+    ARRAY_FOREACH(p, _shared) {
+        if (*p == comp) {
+            *p = _shared.last();
+            _shared.pop();
+            break;
+        }
+    }
+    return true;
+}
+
+
+/* Renders the frames of the exported range in its own build states and canvas.
+   The frames are built one by one in the shared composition, then rasterized in parallel. */
+struct LottieFrameTask : Task
+{
+    LottieComposition* comp;
+    LottieBuilder* builder;
+    LottieState* state;
+    Canvas* canvas = nullptr;
+    uint32_t* buffer;
+    Matrix m;
+    uint32_t w, h;
+    ColorSpace cs;
+    float frameNo = 0.0f;
+    bool owner;           //the builder is owned by this task
+    bool drawn = false;
+
+    LottieFrameTask(LottieComposition* comp, LottieBuilder* builder, float sx, float sy, uint32_t w, uint32_t h, ColorSpace cs) : comp(comp), w(w), h(h), cs(cs)
+    {
+        //the expressions are evaluated by the engine of the animation builder
+        owner = !builder;
+        this->builder = owner ? new LottieBuilder : builder;
+
+        ScopedLock lock(comp->key);
+        state = new LottieState(comp);
+        state->layers[0].scene = Scene::gen();
+        state->initiated = true;
+
+        m = {sx, 0, 0, 0, sy, 0, 0, 0, 1};
+        if (owner) this->builder->resize(std::max(sx, sy));
+        buffer = tvg::malloc<uint32_t*>(w * h * sizeof(uint32_t));
+    }
+
+    ~LottieFrameTask()
+    {
+        done();
+        if (canvas) delete(canvas);
+        else delete(state->scene());
+        {
+            ScopedLock lock(comp->key);
+            delete(state);
+        }
+        if (owner) delete(builder);
+        tvg::free(buffer);
+    }
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        //the canvas of this worker waits for its raster tasks, they mustn't wait behind the other busy workers
+        TaskScheduler::inplace(true);
+
+        //the renderer takes its own memory pool on the worker thread
+        if (!canvas) {
+            auto canvas = SwCanvas::gen();
+            if (canvas) {
+                auto scene = state->scene();
+                auto clipper = Shape::gen();
+                clipper->appendRect(0, 0, comp->w, comp->h);
+                clipper->transform(m);
+                scene->clip(clipper);
+                scene->transform(m);
+                canvas->target(buffer, w, w, h, cs);
+                canvas->push(scene);
+                this->canvas = canvas;
+            }
+        }
+
+        drawn = false;
+
+        if (canvas) {
+            {
+                ScopedLock lock(comp->key);
+                state->swap();
+                builder->update(comp, frameNo, true);
+                state->swap();
+            }
+            canvas->update();
+            if (canvas->draw(true) == Result::Success && canvas->sync() == Result::Success) drawn = true;
+        }
+
+        TaskScheduler::inplace(false);
+    }
+};
+
+
 void LottieLoader::run(unsigned tid)
 {
+    //build the next frame ahead
+    if (prefetching) {
+        build(back, prefetched, false);
+        prefetching = false;
+        return;
+    }
+
     //update frame
     if (comp) {
-        builder->update(comp, frameNo);
+        build(state, frameNo, false);
     //initial loading
     } else {
         LottieParser parser(content, dirName, builder->expressions());
+        parser.deferrable = path || !copy;
         if (!parser.parse()) return;
         {
             ScopedLock lock(key);
             comp = parser.comp;
         }
+        if (path) comp->path = duplicate(path);
+        //the deferred assets are parsed from the source later, the read file is taken over
+        if (!comp->deferrals.empty()) {
+            comp->source = {content, size, copy};
+            if (copy) content = nullptr;
+        }
         if (parser.slots) {
             override(parser.slots, true);
             parser.slots = nullptr;
         }
-        builder->build(comp);
+        share();
+        build(state, frameNo, true);
 
         release();
     }
@@ -55,6 +190,54 @@ void LottieLoader::run(unsigned tid)
 }
 
 
+void LottieLoader::build(LottieState* state, float no, bool initial)
+{
+    //the shared composition takes the own states of this animation while building it
+    if (state) {
+        ScopedLock lock(comp->key);
+        //the states are grown by the other animations, thus checked in the lock
+        if (!state->scene()) initial = true;
+        state->swap();
+        if (initial) builder->build(comp);
+        else builder->update(comp, no, instancing);
+        state->swap();
+        return;
+    }
+
+    if (initial) builder->build(comp);
+    else builder->update(comp, no, instancing);
+}
+
+
+void LottieLoader::share()
+{
+    //the animation data without the overridable properties is not changed by the animations
+    if (!path || comp->expressions || !comp->slots.empty()) return;
+
+    ScopedLock lock(_key);
+
+    //the same file has been loaded by another animation in the meantime
+    ARRAY_FOREACH(p, _shared) {
+        if (!strcmp((*p)->path, path)) return;
+    }
+
+    comp->share();
+    _shared.push(comp);
+    state = new LottieState(comp);
+}
+
+
+//the composition takes the fresh states, the built ones are moved to the front generation
+void LottieLoader::split()
+{
+    if (state) return;
+    comp->share();
+    state = new LottieState(comp);
+    state->swap();
+    std::swap(state->initiated, comp->initiated);
+}
+
+
 void LottieLoader::release()
 {
     if (copy) {
@@ -64,6 +247,142 @@ void LottieLoader::release()
 }
 
 
+//build the predicted next frame in the back generation while the current one is rendered
+void LottieLoader::ahead()
+{
+    if (builder->tweening() || tvg::zero(step)) return;
+
+    //the playback continues in the same direction, looping in the segment
+    auto next = frameNo + step;
+    auto range = segmentEnd - segmentBegin;
+    if (range > 0.0f) {
+        if (next > segmentEnd) next = segmentBegin + fmodf(next - segmentEnd, range);
+        else if (next < segmentBegin) next = segmentEnd - fmodf(segmentBegin - next, range);
+    }
+    next = nearbyintf(next * 10000.0f) * 0.0001f;
+    if (budget > 0) {
+        next = nearbyintf(next);
+        if (cached(next)) return;
+    }
+
+    if (tvg::equal(prefetched, next) || fabsf(frameNo - next) <= 0.0009f) return;
+
+    prefetched = next;
+    prefetching = true;
+    TaskScheduler::request(this);
+}
+
+
+//bring the frame built ahead to the front, the picture keeps the same root scene
+void LottieLoader::flip()
+{
+    ScopedLock lock(comp->key);
+
+    auto front = state->scene();
+    auto staged = back->scene();
+
+    front->remove();
+
+    auto& paints = staged->paints();
+    while (!paints.empty()) {
+        auto paint = paints.front();
+        paint->ref();
+        staged->remove(paint);
+        front->push(paint);
+        paint->unref(false);
+    }
+
+    std::swap(state->layers[0].scene, back->layers[0].scene);
+    std::swap(state->initiated, back->initiated);
+    std::swap(state, back);
+
+    prefetched = -1.0f;
+}
+
+
+//the frame built ahead is outdated by the changes of the animation
+void LottieLoader::discard()
+{
+    if (!back) return;
+    done();
+    prefetched = -1.0f;
+}
+
+
+//the repeaters are built by the shape instances once the scene is bound to the renderer supporting them
+void LottieLoader::bind()
+{
+    if (auto renderer = PAINT(root())->renderer) {
+        instancing = renderer->instancing();
+        coarse = renderer->quality() >= CoarseFrame;
+    }
+}
+
+
+Scene* LottieLoader::root()
+{
+    if (state) {
+        ScopedLock lock(comp->key);
+        return state->scene();
+    }
+    return comp->root->scene;
+}
+
+
+Picture* LottieLoader::cached(float no)
+{
+    ARRAY_FOREACH(p, frames) {
+        if (tvg::equal(p->no, no)) return p->picture;
+    }
+    return nullptr;
+}
+
+
+//render the built frame into an image, the next loops draw it instead of the scene
+void LottieLoader::capture()
+{
+    auto no = pending;
+    pending = -1.0f;
+
+    auto sw = vw > 0.0f ? vw : w;
+    auto sh = vh > 0.0f ? vh : h;
+    auto iw = static_cast<uint32_t>(nearbyintf(sw));
+    auto ih = static_cast<uint32_t>(nearbyintf(sh));
+    auto size = iw * ih * sizeof(uint32_t);
+
+    if (size == 0 || used + size > budget || cached(no)) return;
+
+    auto canvas = SwCanvas::gen();
+    if (!canvas) return;
+
+    auto buffer = tvg::calloc<uint32_t*>(iw * ih, sizeof(uint32_t));
+    canvas->target(buffer, iw, iw, ih, ColorSpace::ARGB8888);
+    canvas->push(root()->duplicate());
+
+    if (canvas->draw() == Result::Success && canvas->sync() == Result::Success) {
+        auto picture = Picture::gen();
+        picture->load(buffer, iw, ih, ColorSpace::ARGB8888, true);
+        //the root scene scales the image back to the picture size
+        picture->transform({w / sw, 0, 0, 0, h / sh, 0, 0, 0, 1});
+        picture->ref();
+        frames.push({picture, no, (uint32_t)size});
+        used += size;
+    }
+
+    delete(canvas);
+    tvg::free(buffer);
+}
+
+
+void LottieLoader::flush()
+{
+    ARRAY_FOREACH(p, frames) p->picture->unref();
+    frames.reset();
+    used = 0;
+    pending = -1.0f;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -79,12 +398,23 @@ LottieLoader::~LottieLoader()
     done();
 
     release();
+    flush();
+
+    if (state) {
+        {
+            ScopedLock lock(comp->key);
+            delete(back);
+            delete(state);
+        }
+        if (!_unshare(comp)) comp = nullptr;
+    }
 
     //TODO: correct position?
     delete(comp);
     delete(builder);
 
     tvg::free(dirName);
+    tvg::free(path);
 }
 
 
@@ -219,7 +549,21 @@ bool LottieLoader::open(const char* data, uint32_t size, const char* rpath, bool
 bool LottieLoader::open(const char* path)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    auto f = fopen(path, "r");
+    //the same file is already loaded, share the composition
+    if (auto comp = _share(path)) {
+        {
+            ScopedLock lock(comp->key);
+            state = new LottieState(comp);
+        }
+        this->comp = comp;
+        w = comp->w;
+        h = comp->h;
+        segmentEnd = frameCnt = comp->frameCnt();
+        frameRate = comp->frameRate;
+        return true;
+    }
+
+    auto f = fopen(path, "rb");
     if (!f) return false;
 
     fseek(f, 0, SEEK_END);
@@ -238,6 +582,7 @@ bool LottieLoader::open(const char* path)
     fclose(f);
 
     this->dirName = tvg::dirname(path);
+    this->path = duplicate(path);
     this->content = content;
     this->copy = true;
 
@@ -252,6 +597,20 @@ bool LottieLoader::resize(Paint* paint, float w, float h)
 {
     if (!paint) return false;
 
+    //the rendered frames are matched with the picture size
+    if (!tvg::equal(vw, w) || !tvg::equal(vh, h)) {
+        auto drawn = cached(frameNo);
+        if (drawn && !PAINT(drawn)->parent) drawn = nullptr;
+        flush();
+        vw = w;
+        vh = h;
+        //the frozen precomps are rasterized in the picture scale
+        done();
+        builder->resize(std::max(w / this->w, h / this->h));
+        //the frame image of the previous size is replaced with the scene
+        if (drawn) build(state, frameNo, false);
+    }
+
     auto sx = w / this->w;
     auto sy = h / this->h;
     Matrix m = {sx, 0, 0, 0, sy, 0, 0, 0, 1};
@@ -270,7 +629,7 @@ bool LottieLoader::read()
     //the loading has been already completed
     if (!LoadModule::read()) return true;
 
-    if (!content || size == 0) return false;
+    if (!comp && (!content || size == 0)) return false;
 
     TaskScheduler::request(this);
 
@@ -278,11 +637,38 @@ bool LottieLoader::read()
 }
 
 
+void LottieLoader::memory(RenderMemory& out)
+{
+    done();
+
+    //the source data is released once the model is parsed, or retained by the composition for the deferred assets
+    if (copy && content) out[MemoryType::Resource] += size;
+
+    //the parsed model, split among the animations sharing it
+    if (comp) {
+        ScopedLock lock(comp->key);
+        out[MemoryType::Resource] += comp->memory() / (comp->sharing > 0 ? comp->sharing : 1);
+    }
+
+    //the rendered frames out of the scene
+    ARRAY_FOREACH(p, frames) {
+        if (!PAINT(p->picture)->parent) PAINT(p->picture)->memory(out);
+    }
+}
+
+
 Paint* LottieLoader::paint()
 {
     done();
 
     if (!comp) return nullptr;
+
+    if (state) {
+        ScopedLock lock(comp->key);
+        state->initiated = true;
+        return state->scene();
+    }
+
     comp->initiated = true;
     return comp->root->scene;
 }
@@ -292,6 +678,8 @@ bool LottieLoader::override(const char* slots, bool byDefault)
 {
     if (!ready() || comp->slots.count == 0) return false;
 
+    discard();
+
     //override slots
     if (slots) {
         //Copy the input data because the JSON parser will encode the data immediately.
@@ -314,12 +702,20 @@ bool LottieLoader::override(const char* slots, bool byDefault)
             ++idx;
         }
         tvg::free((char*)temp);
+        if (succeed) {
+            flush();
+            builder->invalidate();
+            if (back) back->invalidate();
+        }
         rebuild = succeed;
         overridden |= succeed;
         return rebuild;
     //reset slots
     } else if (overridden) {
         ARRAY_FOREACH(p, comp->slots) (*p)->reset();
+        flush();
+        builder->invalidate();
+        if (back) back->invalidate();
         overridden = false;
         rebuild = true;
     }
@@ -338,15 +734,38 @@ bool LottieLoader::frame(float no)
 {
     no = shorten(no);
 
+    //the rendered frames are the whole frames, so as the frames of the lowered quality (known by the former frame)
+    if (budget > 0 || coarse) no = nearbyintf(no);
+
     //Skip update if frame diff is too small.
     if (!builder->tweening() && fabsf(this->frameNo - no) <= 0.0009f) return false;
 
     this->done();
+    bind();
 
+    if (pending >= 0.0f && !rebuild) capture();
+
+    step = no - this->frameNo;
     this->frameNo = no;
 
     builder->offTween();
 
+    //the frame has been rendered in the previous loops
+    if (auto picture = cached(no)) {
+        auto scene = root();
+        scene->remove();
+        scene->push(picture);
+        return true;
+    }
+
+    if (budget > 0) pending = no;
+
+    //the frame has been built ahead
+    if (back && tvg::equal(prefetched, no)) {
+        flip();
+        return true;
+    }
+
     TaskScheduler::request(this);
 
     return true;
@@ -382,6 +801,8 @@ void LottieLoader::sync()
     done();
 
     if (rebuild) run(0);
+
+    if (back) ahead();
 }
 
 
@@ -447,8 +868,11 @@ bool LottieLoader::tween(float from, float to, float progress)
     else if (tvg::equal(progress, 1.0f)) return frame(to);
 
     done();
+    bind();
 
     frameNo = shorten(from);
+    prefetched = -1.0f;
+    pending = -1.0f;
 
     builder->onTween(shorten(to), progress);
 
@@ -461,7 +885,130 @@ bool LottieLoader::tween(float from, float to, float progress)
 bool LottieLoader::assign(const char* layer, uint32_t ix, const char* var, float val)
 {
     if (!ready() || !comp->expressions) return false;
+    discard();
+    flush();
     comp->root->assign(layer, ix, var, val);
 
     return true;
-}
\ No newline at end of file
+}
+
+
+bool LottieLoader::prefetch(bool on)
+{
+    if (!ready()) return false;
+    if (on == (back != nullptr)) return true;
+
+    done();
+
+    ScopedLock lock(comp->key);
+
+    if (!on) {
+        delete(back);
+        back = nullptr;
+        prefetched = -1.0f;
+        return true;
+    }
+
+    split();
+
+    //the back generation builds the frames in its own root scene
+    back = new LottieState(comp);
+    back->layers[0].scene = Scene::gen();
+
+    return true;
+}
+
+
+bool LottieLoader::cache(uint32_t budget)
+{
+    if (!ready()) return false;
+
+    done();
+    flush();
+
+    this->budget = budget;
+
+    return true;
+}
+
+
+bool LottieLoader::freeze(bool on)
+{
+    if (!ready()) return false;
+    if (builder->freezing == on) return true;
+
+    discard();
+    flush();
+
+    builder->freezing = on;
+    //the rasters are released by the analysis, the frame is built again with the vectors or the rasters
+    builder->invalidate();
+    if (back) back->invalidate();
+    rebuild = true;
+
+    return true;
+}
+
+
+Result LottieLoader::render(float begin, float end, float step, uint32_t workers, ColorSpace cs, float sw, float sh, std::function<bool(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data)> func, void* data)
+{
+    if (!ready()) return Result::InsufficientCondition;
+
+    done();
+
+    //the frames of the picture size
+    auto iw = static_cast<uint32_t>(nearbyintf(sw));
+    auto ih = static_cast<uint32_t>(nearbyintf(sh));
+    if (iw == 0 || ih == 0) return Result::InsufficientCondition;
+
+    if (begin < 0.0f) begin = 0.0f;
+    if (end > frameCnt) end = frameCnt;
+
+    if (begin >= end) return Result::Success;
+
+    //too many frames for the step
+    auto frames = ceilf((end - begin) / step);
+    if (frames > float(UINT32_MAX)) return Result::InvalidArguments;
+    auto cnt = static_cast<uint32_t>(frames);
+
+    //the expressions engine builds the frames one by one
+    auto threads = TaskScheduler::threads();
+    if (workers == 0 || workers > threads) workers = threads;
+    if (workers > cnt) workers = cnt;
+    if (workers == 0 || comp->expressions) workers = 1;
+
+    {
+        ScopedLock lock(comp->key);
+        split();
+    }
+
+    Array<LottieFrameTask*> tasks;
+    tasks.reserve(workers);
+    for (uint32_t i = 0; i < workers; ++i) {
+        tasks.push(new LottieFrameTask(comp, comp->expressions ? builder : nullptr, sw / w, sh / h, iw, ih, cs));
+    }
+
+    //the frames are rendered by the workers in turn, then delivered in order
+    for (uint32_t i = 0; i < workers; ++i) {
+        tasks[i]->frameNo = shorten(begin + step * i);
+        TaskScheduler::request(tasks[i]);
+    }
+
+    auto ret = Result::Success;
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto task = tasks[i % workers];
+        task->done();
+        if (!task->drawn || !func(task->buffer, iw, ih, begin + step * i, data)) {
+            if (!task->drawn) ret = Result::Unknown;
+            break;
+        }
+        if (i + workers < cnt) {
+            task->frameNo = shorten(begin + step * (i + workers));
+            TaskScheduler::request(task);
+        }
+    }
+
+    ARRAY_FOREACH(p, tasks) delete(*p);
+
+    return ret;
+}
@@ -28,11 +28,20 @@
 #include "tvgTaskScheduler.h"
 
 struct LottieComposition;
+struct LottieState;
 struct LottieBuilder;
 
 class LottieLoader : public FrameModule, public Task
 {
 public:
+    //the rendered image of a frame
+    struct Frame
+    {
+        Picture* picture;
+        float no;
+        uint32_t size;
+    };
+
     const char* content = nullptr;      //lottie file data
     uint32_t size = 0;                  //lottie data size
     float frameNo = 0.0f;               //current frame number
@@ -41,12 +50,25 @@ public:
 
     LottieBuilder* builder;
     LottieComposition* comp = nullptr;
+    LottieState* state = nullptr;       //own build states of the shared composition
+    LottieState* back = nullptr;        //the back generation building the next frame ahead
+    float prefetched = -1.0f;           //the frame number built in the back generation
+    float step = 0.0f;                  //the last frame step, predicts the next frame
+    Array<Frame> frames;                //the rendered frames of the looping playback
+    uint32_t budget = 0;                //memory budget of the rendered frames in bytes, 0 disables it
+    uint32_t used = 0;                  //memory used by the rendered frames
+    float vw = 0.0f, vh = 0.0f;         //the size of the picture, the rendered frames are matched with
+    float pending = -1.0f;              //the built frame to be rendered for the next loops
 
     Key key;
     char* dirName = nullptr;            //base resource directory
+    char* path = nullptr;               //source file path, the key of the shared composition
     bool copy = false;                  //"content" is owned by this loader
     bool overridden = false;            //overridden properties with slots
     bool rebuild = false;               //require building the lottie scene
+    bool prefetching = false;           //this task builds the back generation
+    bool instancing = false;            //the renderer of the scene draws the shape instances
+    bool coarse = false;                //the canvas lowered the quality for its frame budget, builds the whole frames
 
     LottieLoader();
     ~LottieLoader();
@@ -55,6 +77,7 @@ public:
     bool open(const char* data, uint32_t size, const char* rpath, bool copy) override;
     bool resize(Paint* paint, float w, float h) override;
     bool read() override;
+    void memory(RenderMemory& out) override;
     Paint* paint() override;
     bool override(const char* slot, bool byDefault = false);
 
@@ -74,6 +97,10 @@ public:
     float shorten(float frameNo);  //Reduce the accuracy for performance
     bool tween(float from, float to, float progress);
     bool assign(const char* layer, uint32_t ix, const char* var, float val);
+    bool prefetch(bool on);
+    bool cache(uint32_t budget);
+    bool freeze(bool on);
+    Result render(float begin, float end, float step, uint32_t workers, ColorSpace cs, float sw, float sh, std::function<bool(const uint32_t* buffer, uint32_t w, uint32_t h, float frameNo, void* data)> func, void* data);
 
 private:
     bool ready();
@@ -81,7 +108,18 @@ private:
     void clear();
     float startFrame();
     void run(unsigned tid) override;
+    void build(LottieState* state, float no, bool initial);
+    void share();
+    void split();
     void release();
+    void ahead();
+    void flip();
+    void discard();
+    void bind();
+    Scene* root();
+    Picture* cached(float no);
+    void capture();
+    void flush();
 };
 
 
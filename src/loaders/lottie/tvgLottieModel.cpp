@@ -23,6 +23,7 @@
 #include "tvgMath.h"
 #include "tvgTaskScheduler.h"
 #include "tvgLottieModel.h"
+#include "tvgLottieParser.h"
 #include "tvgCompressor.h"
 
 
@@ -57,6 +58,302 @@ Point LottieTextFollowPath::split(float dLen, float lenSearched, float& angle)
     return {};
 }
 
+
+static void _collect(LottieComposition* comp, LottieGroup* group)
+{
+    auto& stateful = comp->stateful;
+
+    stateful.shapes.push(group);
+
+    if (group->type == LottieObject::Layer) {
+        auto layer = static_cast<LottieLayer*>(group);
+        stateful.layers.push(layer);
+        stateful.statics.push(&layer->statical);
+        stateful.scenes.push(&layer->scenes);
+        stateful.scenes.push(&layer->wrappers);
+        //the referenced precomp or image is the asset, collected once
+        if (layer->rid) return;
+    }
+
+    ARRAY_FOREACH(p, group->children) {
+        auto child = *p;
+        switch (child->type) {
+            case LottieObject::Layer:
+            case LottieObject::Group: {
+                _collect(comp, static_cast<LottieGroup*>(child));
+                break;
+            }
+            case LottieObject::Rect:
+            case LottieObject::Ellipse:
+            case LottieObject::Path:
+            case LottieObject::Polystar: {
+                stateful.shapes.push(static_cast<LottieShape*>(child));
+                break;
+            }
+            case LottieObject::Text: {
+                auto text = static_cast<LottieText*>(child);
+                stateful.shapes.push(text);
+                stateful.scenes.push(&text->lines);
+                stateful.scenes.push(&text->groups);
+                break;
+            }
+            default: break;
+        }
+    }
+}
+
+
+/* Only the prepared paints are duplicated for this animation, the others are generated on demand.
+   Those are reassigned with the frame properties whenever they are used, so the composition
+   could have been built already. */
+template<typename T>
+static Array<T*>* _prepare(Array<LottieRenderPooler<T>*>& targets, bool prepared, Array<T*>* prev = nullptr, uint32_t cnt = 0)
+{
+    auto poolers = new Array<T*>[targets.count];
+
+    //keep the former ones, the targets have been grown
+    for (uint32_t i = 0; i < cnt; ++i) poolers[i].swap(prev[i]);
+    delete[] prev;
+
+    if (!prepared) return poolers;
+
+    for (uint32_t i = cnt; i < targets.count; ++i) {
+        auto& src = targets[i]->pooler;
+        if (src.empty()) continue;
+        auto paint = static_cast<T*>(src[0]->duplicate());
+        paint->ref();
+        poolers[i].push(paint);
+    }
+    return poolers;
+}
+
+
+template<typename T>
+static void _release(Array<T*>* poolers, uint32_t cnt)
+{
+    for (uint32_t i = 0; i < cnt; ++i) {
+        ARRAY_FOREACH(p, poolers[i]) (*p)->unref();
+    }
+    delete[] poolers;
+}
+
+
+template<typename T>
+static void _swap(Array<LottieRenderPooler<T>*>& targets, Array<T*>* poolers)
+{
+    for (uint32_t i = 0; i < targets.count; ++i) {
+        targets[i]->pooler.swap(poolers[i]);
+    }
+}
+
+
+static size_t _memory(const RenderPath& path)
+{
+    return path.cmds.reserved * sizeof(PathCommand) + path.pts.reserved * sizeof(Point);
+}
+
+
+static size_t _memory(const char* str)
+{
+    return str ? strlen(str) + 1 : 0;
+}
+
+
+static size_t _memory(LottieStroke* stroke)
+{
+    auto size = stroke->width.memory();
+    if (auto dash = stroke->dashattr) {
+        size += sizeof(LottieStroke::DashAttr) + dash->offset.memory() + dash->allocated * sizeof(LottieFloat);
+        for (uint8_t i = 0; i < dash->size; ++i) size += dash->values[i].memory();
+    }
+    return size;
+}
+
+
+static size_t _memory(LottieGradient* gradient)
+{
+    return gradient->start.memory() + gradient->end.memory() + gradient->height.memory() + gradient->angle.memory() + gradient->opacity.memory() + gradient->colorStops.memory();
+}
+
+
+static size_t _memory(LottieTransform* transform)
+{
+    auto size = sizeof(LottieTransform) + transform->position.memory() + transform->rotation.memory() + transform->scale.memory() + transform->anchor.memory() + transform->opacity.memory() + transform->skewAngle.memory() + transform->skewAxis.memory();
+    if (auto coords = transform->coords) size += sizeof(LottieTransform::SeparateCoord) + coords->x.memory() + coords->y.memory();
+    if (auto rotationEx = transform->rotationEx) size += sizeof(LottieTransform::RotationEx) + rotationEx->x.memory() + rotationEx->y.memory();
+    return size;
+}
+
+
+static size_t _memory(LottieEffect* effect)
+{
+    switch (effect->type) {
+        case LottieEffect::Custom: {
+            auto custom = static_cast<LottieFxCustom*>(effect);
+            auto size = sizeof(LottieFxCustom) + custom->props.reserved * sizeof(LottieFxCustom::Property);
+            ARRAY_FOREACH(p, custom->props) size += p->property->memory();
+            return size;
+        }
+        case LottieEffect::Tint: {
+            auto tint = static_cast<LottieFxTint*>(effect);
+            return sizeof(LottieFxTint) + tint->black.memory() + tint->white.memory() + tint->intensity.memory();
+        }
+        case LottieEffect::Fill: {
+            auto fill = static_cast<LottieFxFill*>(effect);
+            return sizeof(LottieFxFill) + fill->color.memory() + fill->opacity.memory();
+        }
+        case LottieEffect::Stroke: {
+            auto stroke = static_cast<LottieFxStroke*>(effect);
+            return sizeof(LottieFxStroke) + stroke->mask.memory() + stroke->allMask.memory() + stroke->color.memory() + stroke->size.memory() + stroke->opacity.memory() + stroke->begin.memory() + stroke->end.memory();
+        }
+        case LottieEffect::Tritone: {
+            auto tritone = static_cast<LottieFxTritone*>(effect);
+            return sizeof(LottieFxTritone) + tritone->bright.memory() + tritone->midtone.memory() + tritone->dark.memory();
+        }
+        case LottieEffect::DropShadow: {
+            auto shadow = static_cast<LottieFxDropShadow*>(effect);
+            return sizeof(LottieFxDropShadow) + shadow->color.memory() + shadow->opacity.memory() + shadow->angle.memory() + shadow->distance.memory() + shadow->blurness.memory();
+        }
+        case LottieEffect::GaussianBlur: {
+            auto blur = static_cast<LottieFxGaussianBlur*>(effect);
+            return sizeof(LottieFxGaussianBlur) + blur->blurness.memory() + blur->direction.memory() + blur->wrap.memory();
+        }
+    }
+    return 0;
+}
+
+
+static size_t _memory(LottieTextRange* range)
+{
+    auto& style = range->style;
+    auto size = sizeof(LottieTextRange) + style.fillColor.memory() + style.strokeColor.memory() + style.position.memory() + style.scale.memory() + style.letterSpacing.memory() + style.lineSpacing.memory() + style.strokeWidth.memory() + style.rotation.memory() + style.fillOpacity.memory() + style.strokeOpacity.memory() + style.opacity.memory();
+    size += range->offset.memory() + range->maxEase.memory() + range->minEase.memory() + range->maxAmount.memory() + range->smoothness.memory() + range->start.memory() + range->end.memory();
+    if (range->interpolator) size += sizeof(LottieInterpolator);
+    return size;
+}
+
+
+static size_t _memory(LottieShape* shape)
+{
+    if (!shape->modified) return 0;
+    return sizeof(LottieModifierCache) + _memory(shape->modified->in) + _memory(shape->modified->out);
+}
+
+
+static size_t _memory(LottieObject* obj);
+
+
+static size_t _memory(LottieGroup* group)
+{
+    auto size = group->children.reserved * sizeof(LottieObject*);
+    ARRAY_FOREACH(p, group->children) size += _memory(*p);
+    return size;
+}
+
+
+static size_t _memory(LottieLayer* layer)
+{
+    auto size = sizeof(LottieLayer) + layer->timeRemap.memory() + _memory(layer->name);
+
+    //the children of the precomp belong to the asset
+    if (!layer->rid) size += _memory(static_cast<LottieGroup*>(layer));
+    if (layer->transform) size += _memory(layer->transform);
+
+    size += layer->masks.reserved * sizeof(LottieMask*);
+    ARRAY_FOREACH(p, layer->masks) {
+        auto mask = *p;
+        size += sizeof(LottieMask) + mask->pathset.memory() + mask->expand.memory() + mask->opacity.memory();
+    }
+
+    size += layer->effects.reserved * sizeof(LottieEffect*);
+    ARRAY_FOREACH(p, layer->effects) size += _memory(*p);
+
+    return size;
+}
+
+
+static size_t _memory(LottieObject* obj)
+{
+    switch (obj->type) {
+        case LottieObject::Layer: return _memory(static_cast<LottieLayer*>(obj));
+        case LottieObject::Group: return sizeof(LottieGroup) + _memory(static_cast<LottieGroup*>(obj));
+        case LottieObject::Transform: return _memory(static_cast<LottieTransform*>(obj));
+        case LottieObject::SolidFill: {
+            auto fill = static_cast<LottieSolidFill*>(obj);
+            return sizeof(LottieSolidFill) + fill->color.memory() + fill->opacity.memory();
+        }
+        case LottieObject::SolidStroke: {
+            auto stroke = static_cast<LottieSolidStroke*>(obj);
+            return sizeof(LottieSolidStroke) + stroke->color.memory() + stroke->opacity.memory() + _memory(static_cast<LottieStroke*>(stroke));
+        }
+        case LottieObject::GradientFill: {
+            return sizeof(LottieGradientFill) + _memory(static_cast<LottieGradient*>(static_cast<LottieGradientFill*>(obj)));
+        }
+        case LottieObject::GradientStroke: {
+            auto stroke = static_cast<LottieGradientStroke*>(obj);
+            return sizeof(LottieGradientStroke) + _memory(static_cast<LottieGradient*>(stroke)) + _memory(static_cast<LottieStroke*>(stroke));
+        }
+        case LottieObject::Rect: {
+            auto rect = static_cast<LottieRect*>(obj);
+            return sizeof(LottieRect) + rect->position.memory() + rect->size.memory() + rect->radius.memory() + _memory(static_cast<LottieShape*>(rect));
+        }
+        case LottieObject::Ellipse: {
+            auto ellipse = static_cast<LottieEllipse*>(obj);
+            return sizeof(LottieEllipse) + ellipse->position.memory() + ellipse->size.memory() + _memory(static_cast<LottieShape*>(ellipse));
+        }
+        case LottieObject::Path: {
+            auto path = static_cast<LottiePath*>(obj);
+            return sizeof(LottiePath) + path->pathset.memory() + _memory(static_cast<LottieShape*>(path));
+        }
+        case LottieObject::Polystar: {
+            auto star = static_cast<LottiePolyStar*>(obj);
+            return sizeof(LottiePolyStar) + star->position.memory() + star->innerRadius.memory() + star->outerRadius.memory() + star->innerRoundness.memory() + star->outerRoundness.memory() + star->rotation.memory() + star->ptsCnt.memory() + _memory(static_cast<LottieShape*>(star));
+        }
+        case LottieObject::Image: {
+            return sizeof(LottieImage) + static_cast<LottieImage*>(obj)->data.memory();
+        }
+        case LottieObject::Trimpath: {
+            auto trimpath = static_cast<LottieTrimpath*>(obj);
+            return sizeof(LottieTrimpath) + trimpath->start.memory() + trimpath->end.memory() + trimpath->offset.memory();
+        }
+        case LottieObject::Text: {
+            auto text = static_cast<LottieText*>(obj);
+            auto size = sizeof(LottieText) + text->doc.memory() + text->alignOption.anchor.memory() + text->ranges.reserved * sizeof(LottieTextRange*);
+            ARRAY_FOREACH(p, text->ranges) size += _memory(*p);
+            if (text->followPath) size += sizeof(LottieTextFollowPath) + text->followPath->firstMargin.memory();
+            return size + text->layout.glyphs.reserved * sizeof(LottieGlyph*) + _memory(text->layout.text);
+        }
+        case LottieObject::Repeater: {
+            auto repeater = static_cast<LottieRepeater*>(obj);
+            return sizeof(LottieRepeater) + repeater->copies.memory() + repeater->offset.memory() + repeater->position.memory() + repeater->rotation.memory() + repeater->scale.memory() + repeater->anchor.memory() + repeater->startOpacity.memory() + repeater->endOpacity.memory();
+        }
+        case LottieObject::RoundedCorner: {
+            auto corner = static_cast<LottieRoundedCorner*>(obj);
+            return sizeof(LottieRoundedCorner) + corner->radius.memory() + _memory(corner->buffer);
+        }
+        case LottieObject::OffsetPath: {
+            auto offset = static_cast<LottieOffsetPath*>(obj);
+            return sizeof(LottieOffsetPath) + offset->offset.memory() + offset->miterLimit.memory();
+        }
+        default: break;
+    }
+    return 0;
+}
+
+
+static size_t _memory(LottieFont* font)
+{
+    auto size = sizeof(LottieFont) + font->data.size + _memory(font->name) + _memory(font->family) + _memory(font->style) + font->chars.reserved * sizeof(LottieGlyph*);
+    ARRAY_FOREACH(p, font->chars) {
+        auto glyph = *p;
+        size += sizeof(LottieGlyph) + _memory(glyph->code) + glyph->children.reserved * sizeof(LottieObject*);
+        ARRAY_FOREACH(q, glyph->children) size += _memory(*q);
+        if (glyph->path) size += sizeof(RenderSharedPath) + sizeof(RenderSharedPath::Data) + _memory(glyph->path->data->path);
+    }
+    return size;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -344,6 +641,99 @@ float LottieTextRange::factor(float frameNo, float totalLen, float idx)
 }
 
 
+//the static glyph outline is built once, then shared by the text shapes
+void LottieGlyph::prepare()
+{
+    len = strlen(code);
+
+    ARRAY_FOREACH(p, children) {
+        if ((*p)->type != LottieObject::Group) return;
+        ARRAY_FOREACH(p2, static_cast<LottieGroup*>(*p)->children) {
+            if ((*p2)->type != LottieObject::Path) return;
+            auto& pathset = static_cast<LottiePath*>(*p2)->pathset;
+            if (pathset.frames || pathset.exp) return;
+        }
+    }
+
+    path = new RenderSharedPath;
+    auto& out = path->edit();
+    ARRAY_FOREACH(p, children) {
+        ARRAY_FOREACH(p2, static_cast<LottieGroup*>(*p)->children) {
+            static_cast<LottiePath*>(*p2)->pathset.defaultPath(0.0f, out, nullptr);
+        }
+    }
+}
+
+
+static bool _equal(const RGB24& lhs, const RGB24& rhs)
+{
+    return lhs.rgb[0] == rhs.rgb[0] && lhs.rgb[1] == rhs.rgb[1] && lhs.rgb[2] == rhs.rgb[2];
+}
+
+
+//the attributes of the documents except the strings
+static bool _equal(const TextDocument& lhs, const TextDocument& rhs)
+{
+    if (!tvg::equal(lhs.size, rhs.size) || !tvg::equal(lhs.height, rhs.height) || !tvg::equal(lhs.shift, rhs.shift)) return false;
+    if (!tvg::equal(lhs.tracking, rhs.tracking) || !tvg::equal(lhs.justify, rhs.justify) || lhs.caps != rhs.caps) return false;
+    if (lhs.bbox.pos != rhs.bbox.pos || lhs.bbox.size != rhs.bbox.size || !_equal(lhs.color, rhs.color)) return false;
+    if (!tvg::equal(lhs.stroke.width, rhs.stroke.width) || lhs.stroke.below != rhs.stroke.below || !_equal(lhs.stroke.color, rhs.stroke.color)) return false;
+    return true;
+}
+
+
+/* Find the glyphs of the text characters. They are found again only if the text document is changed,
+   walking the characters as the text builder does. */
+LottieGlyph** LottieText::glyphs(const TextDocument& doc)
+{
+    auto same = layout.text && !strcmp(layout.text, doc.text);
+    if (same && _equal(layout.doc, doc)) return layout.glyphs.data;
+
+    //the paints laid out with the former document are outdated
+    ++layout.revision;
+    auto caps = layout.doc.caps;
+    layout.doc = doc;
+    layout.doc.text = layout.doc.name = nullptr;
+
+    if (same && caps == doc.caps) return layout.glyphs.data;
+
+    tvg::free(layout.text);
+    layout.text = duplicate(doc.text);
+
+    auto len = strlen(doc.text);
+    layout.glyphs.reserve(len + 1);
+    layout.glyphs.count = len + 1;
+    memset(layout.glyphs.data, 0x00, sizeof(LottieGlyph*) * layout.glyphs.count);
+
+    auto p = doc.text;
+    while (*p) {
+        if (*p == 13 || *p == 3) {
+            ++p;
+            continue;
+        }
+
+        auto code = p;
+        char capCode;
+        if ((unsigned char)(p[0]) < 0x80 && doc.caps && *p >= 'a' && *p <= 'z') {
+            capCode = *p + 'A' - 'a';
+            code = &capCode;
+        }
+
+        LottieGlyph* found = nullptr;
+        ARRAY_FOREACH(g, font->chars) {
+            if (!strncmp((*g)->code, code, (*g)->len)) {
+                found = *g;
+                break;
+            }
+        }
+        layout.glyphs[p - doc.text] = found;
+        p += found ? found->len : 1;
+    }
+
+    return layout.glyphs.data;
+}
+
+
 void LottieFont::prepare()
 {
     if (!data.b64src || !name) return;
@@ -491,6 +881,7 @@ uint32_t LottieGradient::populate(ColorStop& color, size_t count)
 
     color.input->reset();
     delete(color.input);
+    color.input = nullptr;
 
     return output.count;
 }
@@ -648,6 +1039,8 @@ LottieLayer::~LottieLayer()
 
     delete(transform);
     tvg::free(name);
+
+    cache.release();
 }
 
 
@@ -716,6 +1109,102 @@ bool LottieLayer::assign(const char* layer, uint32_t ix, const char* var, float
 }
 
 
+void LottieComposition::share()
+{
+    sharing = 1;
+
+    _collect(this, root);
+
+    ARRAY_FOREACH(p, assets) {
+        if ((*p)->type == LottieObject::Image) stateful.pictures.push(static_cast<LottieImage*>(*p));
+        else _collect(this, static_cast<LottieLayer*>(*p));
+    }
+}
+
+
+/* Parse the deferred layers of the asset. The animations sharing this composition
+   take their own build states of the new layers, then. */
+bool LottieComposition::inflate(LottieLayer* asset)
+{
+    auto deferral = this->deferral(asset);
+    if (!deferral) return false;
+
+    auto size = deferral->end - deferral->begin + 1;
+    auto json = tvg::malloc<char*>(size + 1);
+    memcpy(json, source.data + deferral->begin, size);
+    json[size] = '\0';
+
+    LottieParser parser(json, nullptr, false);
+    parser.comp = this;
+    auto ret = parser.parse(asset);
+
+    tvg::free(json);
+
+    *deferral = deferrals.last();
+    deferrals.pop();
+
+    //all the assets are parsed, the source is no longer necessary
+    if (deferrals.empty()) {
+        if (source.owner) tvg::free((char*)source.data);
+        source = {};
+    }
+
+    //the broken asset shows nothing, rather than the partial layers
+    if (!ret) {
+        TVGERR("LOTTIE", "Invalid Asset Layers!");
+        ARRAY_FOREACH(p, asset->children) delete(*p);
+        asset->children.reset();
+        return false;
+    }
+
+    if (sharing == 0) return true;
+
+    auto shapes = stateful.shapes.count;
+    auto statics = stateful.statics.count;
+    auto scenes = stateful.scenes.count;
+    auto pictures = stateful.pictures.count;
+    auto layers = stateful.layers.count;
+
+    ARRAY_FOREACH(p, asset->children) _collect(this, static_cast<LottieGroup*>(*p));
+    ARRAY_FOREACH(p, states) (*p)->grow(shapes, statics, scenes, pictures, layers);
+
+    return true;
+}
+
+
+size_t LottieComposition::memory()
+{
+    auto size = sizeof(LottieComposition) + _memory(root) + _memory(version) + _memory(name) + _memory(path);
+
+    size += interpolators.reserved * sizeof(LottieInterpolator*);
+    ARRAY_FOREACH(p, interpolators) size += sizeof(LottieInterpolator) + _memory((*p)->key);
+
+    size += assets.reserved * sizeof(LottieObject*);
+    ARRAY_FOREACH(p, assets) size += _memory(*p);
+
+    size += fonts.reserved * sizeof(LottieFont*);
+    ARRAY_FOREACH(p, fonts) size += _memory(*p);
+
+    size += slots.reserved * sizeof(LottieSlot*);
+    ARRAY_FOREACH(p, slots) {
+        auto slot = *p;
+        size += sizeof(LottieSlot) + _memory(slot->sid) + slot->pairs.reserved * sizeof(LottieSlot::Pair);
+        if (!slot->overridden) continue;
+        ARRAY_FOREACH(pair, slot->pairs) {
+            if (pair->prop) size += pair->prop->memory();
+        }
+    }
+
+    size += markers.reserved * sizeof(LottieMarker*);
+    ARRAY_FOREACH(p, markers) size += sizeof(LottieMarker) + _memory((*p)->name);
+
+    size += deferrals.reserved * sizeof(Deferral);
+    if (source.owner) size += source.size;
+
+    return size;
+}
+
+
 LottieComposition::~LottieComposition()
 {
     if (!initiated && root) delete(root->scene);
@@ -723,6 +1212,8 @@ LottieComposition::~LottieComposition()
     delete(root);
     tvg::free(version);
     tvg::free(name);
+    tvg::free(path);
+    if (source.owner) tvg::free((char*)source.data);
 
     ARRAY_FOREACH(p, interpolators) {
         tvg::free((*p)->key);
@@ -734,3 +1225,75 @@ LottieComposition::~LottieComposition()
     ARRAY_FOREACH(p, slots) delete(*p);
     ARRAY_FOREACH(p, markers) delete(*p);
 }
+
+
+LottieState::LottieState(LottieComposition* comp) : comp(comp)
+{
+    shapes = _prepare(comp->stateful.shapes, false);
+    statics = _prepare(comp->stateful.statics, true);
+    scenes = _prepare(comp->stateful.scenes, false);
+    pictures = _prepare(comp->stateful.pictures, true);
+    layers = new Layer[comp->stateful.layers.count];
+    comp->states.push(this);
+}
+
+
+LottieState::~LottieState()
+{
+    if (!initiated) delete(scene());
+
+    _release(shapes, comp->stateful.shapes.count);
+    _release(statics, comp->stateful.statics.count);
+    _release(scenes, comp->stateful.scenes.count);
+    _release(pictures, comp->stateful.pictures.count);
+    for (uint32_t i = 0; i < comp->stateful.layers.count; ++i) layers[i].cache.release();
+    delete[] layers;
+
+    ARRAY_FOREACH(p, comp->states) {
+        if (*p == this) {
+            *p = comp->states.last();
+            comp->states.pop();
+            break;
+        }
+    }
+}
+
+
+void LottieState::swap()
+{
+    _swap(comp->stateful.shapes, shapes);
+    _swap(comp->stateful.statics, statics);
+    _swap(comp->stateful.scenes, scenes);
+    _swap(comp->stateful.pictures, pictures);
+
+    for (uint32_t i = 0; i < comp->stateful.layers.count; ++i) {
+        auto layer = comp->stateful.layers[i];
+        std::swap(layer->scene, layers[i].scene);
+        std::swap(layer->cache, layers[i].cache);
+    }
+}
+
+
+//the composition has collected the stateful objects of the newly parsed layers
+void LottieState::grow(uint32_t shapes, uint32_t statics, uint32_t scenes, uint32_t pictures, uint32_t layers)
+{
+    this->shapes = _prepare(comp->stateful.shapes, false, this->shapes, shapes);
+    this->statics = _prepare(comp->stateful.statics, true, this->statics, statics);
+    this->scenes = _prepare(comp->stateful.scenes, false, this->scenes, scenes);
+    this->pictures = _prepare(comp->stateful.pictures, true, this->pictures, pictures);
+
+    auto prev = this->layers;
+    this->layers = new Layer[comp->stateful.layers.count];
+    for (uint32_t i = 0; i < layers; ++i) this->layers[i] = prev[i];
+    delete[] prev;
+}
+
+
+//the retained scenes are built with the former properties, build them again
+void LottieState::invalidate()
+{
+    for (uint32_t i = 0; i < comp->stateful.layers.count; ++i) {
+        layers[i].cache.scene = nullptr;
+        layers[i].cache.release();
+    }
+}
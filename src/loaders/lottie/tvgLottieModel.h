@@ -27,6 +27,7 @@
 #include "tvgStr.h"
 #include "tvgCompressor.h"
 #include "tvgRender.h"
+#include "tvgLock.h"
 #include "tvgLottieProperty.h"
 #include "tvgLottieRenderPooler.h"
 
@@ -293,6 +294,7 @@ struct LottieObject
 struct LottieGlyph
 {
     Array<LottieObject*> children;   //glyph shapes.
+    RenderSharedPath* path = nullptr;   //the outline shared by the glyph shapes, null if it's animated
     float width;
     char* code;
     char* family = nullptr;
@@ -300,14 +302,12 @@ struct LottieGlyph
     uint16_t size;
     uint8_t len;
 
-    void prepare()
-    {
-        len = strlen(code);
-    }
+    void prepare();
 
     ~LottieGlyph()
     {
         ARRAY_FOREACH(p, children) delete(*p);
+        delete(path);
         tvg::free(code);
     }
 };
@@ -474,15 +474,29 @@ struct LottieText : LottieObject, LottieRenderPooler<tvg::Shape>
         return nullptr;
     }
 
+    LottieGlyph** glyphs(const TextDocument& doc);
+
     LottieTextDoc doc;
     LottieFont* font = nullptr;
     LottieTextFollowPath* followPath = nullptr;
     Array<LottieTextRange*> ranges;
 
+    LottieRenderPooler<tvg::Scene> lines;    //the text bodies and their line scenes
+    LottieRenderPooler<tvg::Scene> groups;   //the text groups of the glyphs
+
+    //the glyphs found for the characters of the last text document
+    struct {
+        Array<LottieGlyph*> glyphs;   //by the character position, null if not found
+        char* text = nullptr;
+        TextDocument doc;             //the other attributes of the document, the strings are not kept
+        uint32_t revision = 0;        //increased whenever the document is changed
+    } layout;
+
     ~LottieText()
     {
         ARRAY_FOREACH(p, ranges) delete(*p);
         delete(followPath);
+        tvg::free(layout.text);
     }
 };
 
@@ -521,9 +535,13 @@ struct LottieTrimpath : LottieObject
 
 struct LottieShape : LottieObject, LottieRenderPooler<tvg::Shape>
 {
+    LottieModifierCache* modified = nullptr;   //the last output of the modifiers applied to this
     bool clockwise = true;   //clockwise or counter-clockwise
 
-    virtual ~LottieShape() {}
+    virtual ~LottieShape()
+    {
+        delete(modified);
+    }
 
     bool mergeable() override
     {
@@ -551,6 +569,7 @@ struct LottieRoundedCorner : LottieObject
     }
 
     LottieFloat radius = 0.0f;
+    RenderPath buffer;   //reusable path for the roundness modifier
 };
 
 
@@ -791,8 +810,9 @@ struct LottieGradient : LottieObject
         if (!colorStops.populated) {
             auto count = colorStops.count;  //colorstop count can be modified after population
             if (colorStops.frames) {
-                ARRAY_FOREACH(v, *colorStops.frames) {
-                    colorStops.count = populate(v->value, count);
+                auto color = colorStops.frames->value();
+                for (uint32_t i = 0; i < colorStops.frames->count; ++i) {
+                    colorStops.count = populate(color[i], count);
                 }
             } else {
                 colorStops.count = populate(colorStops.value, count);
@@ -988,6 +1008,8 @@ struct LottieLayer : LottieGroup
     LottieLayer* matteTarget = nullptr;
 
     LottieRenderPooler<tvg::Shape> statical;  //static pooler for solid fill and clipper
+    LottieRenderPooler<tvg::Scene> scenes;    //layer scenes, retained across the frames
+    LottieRenderPooler<tvg::Scene> wrappers;  //intermediate scenes for the masking
 
     float timeStretch = 1.0f;
     float w = 0.0f, h = 0.0f;
@@ -999,10 +1021,29 @@ struct LottieLayer : LottieGroup
     int16_t pix = -1;           //index of the parent layer.
     int16_t ix = -1;            //index of the current layer.
 
-    struct {
+    struct Cache
+    {
         float frameNo = -1.0f;
         Matrix matrix;
         uint8_t opacity;
+        Scene* scene = nullptr;  //the retained scene of the constant layer
+        Picture* raster = nullptr;  //the rendered contents of the frozen precomp
+        float rasterScale = 0.0f;   //the scale of the contents in the raster
+        float scale = 1.0f;         //the scale of the outer compositions to the canvas
+        Scene* instance = nullptr;  //the copied contents of the shared asset, kept while the source is the same
+        float instanceNo = -1.0f;   //the asset frame of the instance
+        float instanceScale = 0.0f; //the scale of the asset contents in the instance
+        Scene* text = nullptr;      //the laid out text body, kept while the document revision is the same
+        uint32_t revision = 0;      //the text document revision of the body
+
+        void release()
+        {
+            if (raster) raster->unref();
+            raster = nullptr;
+            if (instance) instance->unref();
+            instance = nullptr;
+            text = nullptr;
+        }
     } cache;
 
     MaskMethod matteType = MaskMethod::None;
@@ -1010,6 +1051,12 @@ struct LottieLayer : LottieGroup
     Type type = Null;
     bool autoOrient = false;
     bool matteSrc = false;
+    bool shared = false;        //the asset layer referenced by the multiple precomps
+    bool deferred = false;      //the referenced asset is not parsed yet, attached when this layer shows up
+    bool constant = false;      //no changes in the active frame range, the scene could be reused
+    bool isolated = false;      //no dependencies on the other layers, the scene could be built concurrently
+    bool frozen = false;        //the precomp contents don't change in the active frame range, those could be rendered once
+    bool steady = false;        //the precomp contents don't change in the active frame range
 
     LottieEffect* effectById(unsigned long id)
     {
@@ -1085,8 +1132,18 @@ struct LottieSlot
 };
 
 
+struct LottieState;
+
 struct LottieComposition
 {
+    //the precomp asset whose layers are parsed when it shows up at first
+    struct Deferral
+    {
+        LottieLayer* asset;
+        uint32_t begin, end;  //the layers range in the source data
+        uint16_t refs;        //the number of the precomps referencing the asset
+    };
+
     ~LottieComposition();
 
     float duration() const
@@ -1127,6 +1184,18 @@ struct LottieComposition
         if (frameNo >= root->outFrame) frameNo = root->outFrame - 1;
     }
 
+    Deferral* deferral(LottieLayer* asset)
+    {
+        ARRAY_FOREACH(p, deferrals) {
+            if (p->asset == asset) return p;
+        }
+        return nullptr;
+    }
+
+    void share();
+    bool inflate(LottieLayer* asset);
+    size_t memory();
+
     LottieLayer* root = nullptr;
     char* version = nullptr;
     char* name = nullptr;
@@ -1137,8 +1206,63 @@ struct LottieComposition
     Array<LottieFont*> fonts;
     Array<LottieSlot*> slots;
     Array<LottieMarker*> markers;
+    Array<Deferral> deferrals;
+    uint32_t revision = 0;       //increased whenever the deferred assets are attached
+
+    //the source data of the deferred assets, retained until they are all parsed
+    struct {
+        const char* data = nullptr;
+        uint32_t size = 0;
+        bool owner = false;      //the data read from the file is taken over from the loader
+    } source;
+
+    //the objects retaining the build states across the frames, collected when the composition is shared
+    struct {
+        Array<LottieRenderPooler<Shape>*> shapes;
+        Array<LottieRenderPooler<Shape>*> statics;   //the prepared clippers and solid fills
+        Array<LottieRenderPooler<Scene>*> scenes;
+        Array<LottieRenderPooler<Picture>*> pictures;
+        Array<LottieLayer*> layers;  //the root layer comes first
+    } stateful;
+    Array<LottieState*> states;   //the own build states of the sharing or prefetching animations
+
+    char* path = nullptr;   //the source file
+    Key key;                //the animations sharing this composition build it one by one
+    uint16_t sharing = 0;   //the number of the animations sharing this composition
     bool expressions = false;
     bool initiated = false;
 };
 
+
+/* The own build states of an animation sharing the composition with the others,
+   or of the frame generation built ahead by the prefetching animation.
+   They are swapped with the composition objects while the animation builds its frame. */
+struct LottieState
+{
+    struct Layer
+    {
+        Scene* scene = nullptr;
+        LottieLayer::Cache cache;
+    };
+
+    LottieState(LottieComposition* comp);
+    ~LottieState();
+    void swap();
+    void grow(uint32_t shapes, uint32_t statics, uint32_t scenes, uint32_t pictures, uint32_t layers);
+    void invalidate();
+
+    Scene* scene()
+    {
+        return layers[0].scene;
+    }
+
+    LottieComposition* comp;
+    Array<Shape*>* shapes;
+    Array<Shape*>* statics;
+    Array<Scene*>* scenes;
+    Array<Picture*>* pictures;
+    Layer* layers;
+    bool initiated = false;
+};
+
 #endif //_TVG_LOTTIE_MODEL_H_
@@ -414,4 +414,92 @@ bool LottieOffsetModifier::modifyEllipse(Point& radius)
     radius.x += offset;
     radius.y += offset;
     return true;
-}
\ No newline at end of file
+}
+
+
+bool LottieModifier::cachedPath(LottieModifierCache& cache, PathCommand* inCmds, uint32_t inCmdsCnt, Point* inPts, uint32_t inPtsCnt, Matrix* transform, RenderPath& out)
+{
+    LottieModifierCache::Key key(this, transform, 0.0f, false);
+
+    if (!cache.reuse(key, inCmds, inCmdsCnt, inPts, inPtsCnt)) {
+        cache.reset(key, inCmds, inCmdsCnt, inPts, inPtsCnt);
+        cache.valid = modifyPath(cache.in.cmds.data, cache.in.cmds.count, cache.in.pts.data, cache.in.pts.count, transform, cache.out);
+        if (!cache.valid) return false;
+    }
+
+    out.cmds.push(cache.out.cmds);
+    out.pts.push(cache.out.pts);
+
+    return true;
+}
+
+
+bool LottieModifier::cachedPolystar(LottieModifierCache& cache, RenderPath& in, RenderPath& out, float outerRoundness, bool hasRoundness)
+{
+    LottieModifierCache::Key key(this, nullptr, outerRoundness, hasRoundness);
+
+    if (!cache.reuse(key, in.cmds.data, in.cmds.count, in.pts.data, in.pts.count)) {
+        cache.reset(key, in.cmds.data, in.cmds.count, in.pts.data, in.pts.count);
+        cache.valid = modifyPolystar(cache.in, cache.out, outerRoundness, hasRoundness);
+        if (!cache.valid) return false;
+    }
+
+    out.cmds.push(cache.out.cmds);
+    out.pts.push(cache.out.pts);
+
+    return true;
+}
+
+
+LottieModifierCache::Key::Key(LottieModifier* modifier, Matrix* transform, float outerRoundness, bool hasRoundness) : outerRoundness(outerRoundness), hasRoundness(hasRoundness)
+{
+    for (auto m = modifier; m; m = m->next) {
+        types |= (1 << m->type);
+        if (m->type == LottieModifier::Roundness) {
+            roundness = static_cast<LottieRoundnessModifier*>(m)->r;
+        } else {
+            auto offset = static_cast<LottieOffsetModifier*>(m);
+            this->offset = offset->offset;
+            miterLimit = offset->miterLimit;
+            join = offset->join;
+        }
+    }
+
+    if (transform) {
+        this->transform = *transform;
+        transformed = true;
+    }
+}
+
+
+bool LottieModifierCache::Key::operator==(const Key& rhs) const
+{
+    if (types != rhs.types || transformed != rhs.transformed || hasRoundness != rhs.hasRoundness || join != rhs.join) return false;
+    if (roundness != rhs.roundness || offset != rhs.offset || miterLimit != rhs.miterLimit || outerRoundness != rhs.outerRoundness) return false;
+    return !transformed || !memcmp(&transform, &rhs.transform, sizeof(Matrix));
+}
+
+
+bool LottieModifierCache::reuse(const Key& key, const PathCommand* cmds, uint32_t cmdsCnt, const Point* pts, uint32_t ptsCnt) const
+{
+    if (!valid || !(this->key == key)) return false;
+    if (in.cmds.count != cmdsCnt || in.pts.count != ptsCnt) return false;
+    return !memcmp(in.cmds.data, cmds, sizeof(PathCommand) * cmdsCnt) && !memcmp(in.pts.data, pts, sizeof(Point) * ptsCnt);
+}
+
+
+//keeps the buffers to be refilled without regrowing
+void LottieModifierCache::reset(const Key& key, const PathCommand* cmds, uint32_t cmdsCnt, const Point* pts, uint32_t ptsCnt)
+{
+    this->key = key;
+    valid = false;
+
+    in.cmds.reserve(cmdsCnt);
+    in.pts.reserve(ptsCnt);
+    if (cmdsCnt > 0) memcpy(in.cmds.data, cmds, sizeof(PathCommand) * cmdsCnt);
+    if (ptsCnt > 0) memcpy(in.pts.data, pts, sizeof(Point) * ptsCnt);
+    in.cmds.count = cmdsCnt;
+    in.pts.count = ptsCnt;
+
+    out.clear();
+}
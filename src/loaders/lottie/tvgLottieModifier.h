@@ -29,6 +29,8 @@
 #include "tvgRender.h"
 
 
+struct LottieModifierCache;
+
 struct LottieModifier
 {
     enum Type : uint8_t {Roundness = 0, Offset};
@@ -41,6 +43,10 @@ struct LottieModifier
     virtual bool modifyPath(PathCommand* inCmds, uint32_t inCmdsCnt, Point* inPts, uint32_t inPtsCnt, Matrix* transform, RenderPath& out) = 0;
     virtual bool modifyPolystar(RenderPath& in, RenderPath& out, float outerRoundness, bool hasRoundness) = 0;
 
+    //same as the above, but reuse the last output of the cache if the input and the modifiers are unchanged
+    bool cachedPath(LottieModifierCache& cache, PathCommand* inCmds, uint32_t inCmdsCnt, Point* inPts, uint32_t inPtsCnt, Matrix* transform, RenderPath& out);
+    bool cachedPolystar(LottieModifierCache& cache, RenderPath& in, RenderPath& out, float outerRoundness, bool hasRoundness);
+
     LottieModifier* decorate(LottieModifier* next)
     {
         /* TODO: build the decorative chaining here.
@@ -106,4 +112,33 @@ private:
     void corner(RenderPath& out, Line& line, Line& nextLine, uint32_t movetoIndex, bool nextClose);
 };
 
+
+//the last output of a modifier chain, kept by the modified shape
+struct LottieModifierCache
+{
+    struct Key
+    {
+        Matrix transform{};
+        float roundness = 0.0f;
+        float offset = 0.0f;
+        float miterLimit = 0.0f;
+        float outerRoundness = 0.0f;
+        StrokeJoin join = StrokeJoin::Miter;
+        uint8_t types = 0;           //bits of the chained modifier types
+        bool transformed = false;
+        bool hasRoundness = false;
+
+        Key() {}
+        Key(LottieModifier* modifier, Matrix* transform, float outerRoundness, bool hasRoundness);
+        bool operator==(const Key& rhs) const;
+    } key;
+
+    RenderPath in;                   //the input of the last output
+    RenderPath out;
+    bool valid = false;
+
+    bool reuse(const Key& key, const PathCommand* cmds, uint32_t cmdsCnt, const Point* pts, uint32_t ptsCnt) const;
+    void reset(const Key& key, const PathCommand* cmds, uint32_t cmdsCnt, const Point* pts, uint32_t ptsCnt);
+};
+
 #endif
\ No newline at end of file
@@ -42,6 +42,62 @@ static unsigned long _int2str(int num)
 }
 
 
+static bool _space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+
+/* Find the end of the raw json array without touching the data. The layers with
+   the slots or the expressions can't be deferred, those need to be registered at loading. */
+static char* _scan(char* p, bool expressions, Array<unsigned long>& refs)
+{
+    auto depth = 1;
+
+    while (*p) {
+        switch (*p) {
+            case '"': {
+                auto str = ++p;
+                while (*p != '"') {
+                    if (*p == '\0') return nullptr;
+                    if (*p == '\\' && *(++p) == '\0') return nullptr;
+                    ++p;
+                }
+                auto len = p - str;
+                auto val = p + 1;
+                while (_space(*val)) ++val;
+                if (*val != ':') break;
+                do ++val; while (_space(*val));
+                if (len == 3 && !strncmp(str, "sid", 3)) return nullptr;
+                if (len == 1 && *str == 'x' && *val == '"' && expressions) return nullptr;
+                //the precomp reference
+                if (len == 5 && !strncmp(str, "refId", 5) && *val == '"') {
+                    auto end = strpbrk(val + 1, "\"\\");
+                    if (!end || *end != '"') return nullptr;
+                    auto id = duplicate(val + 1, end - val - 1);
+                    refs.push(djb2Encode(id));
+                    tvg::free(id);
+                }
+                break;
+            }
+            case '[':
+            case '{': {
+                ++depth;
+                break;
+            }
+            case ']':
+            case '}': {
+                if (--depth == 0) return p;
+                break;
+            }
+            default: break;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+
 LottieExpression* LottieParser::getExpression(char* code, LottieComposition* comp, LottieLayer* layer, LottieObject* object, LottieProperty* property)
 {
     if (!comp->expressions) comp->expressions = true;
@@ -371,6 +427,26 @@ bool LottieParser::parseTangent(const char *key, LottieScalarFrame<T>& value)
 }
 
 
+void LottieParser::indexInterpolators()
+{
+    //keep the load factor under a half so that the probing sequences stay short
+    auto capacity = interpolators.capacity ? interpolators.capacity : 64;
+    while (capacity < (comp->interpolators.count + 1) * 2) capacity <<= 1;
+
+    tvg::free(interpolators.slots);
+    interpolators.slots = tvg::calloc<decltype(interpolators.slots)>(capacity, sizeof(*interpolators.slots));
+    interpolators.capacity = capacity;
+
+    //the composition may have interpolators from the previous parsing (i.e. slots)
+    ARRAY_FOREACH(p, comp->interpolators) {
+        auto hash = djb2Encode((*p)->key);
+        auto idx = hash & (capacity - 1);
+        while (interpolators.slots[idx].interpolator) idx = (idx + 1) & (capacity - 1);
+        interpolators.slots[idx] = {hash, *p};
+    }
+}
+
+
 LottieInterpolator* LottieParser::getInterpolator(const char* key, Point& in, Point& out)
 {
     char buf[20];
@@ -380,30 +456,34 @@ LottieInterpolator* LottieParser::getInterpolator(const char* key, Point& in, Po
         key = buf;
     }
 
-    LottieInterpolator* interpolator = nullptr;
+    if ((comp->interpolators.count + 1) * 2 > interpolators.capacity) indexInterpolators();
 
     //get a cached interpolator if it has any.
-    ARRAY_FOREACH(p, comp->interpolators) {
-        if (!strncmp((*p)->key, key, sizeof(buf))) interpolator = *p;
+    auto hash = djb2Encode(key);
+    auto mask = interpolators.capacity - 1;
+    auto idx = hash & mask;
+
+    for (; interpolators.slots[idx].interpolator; idx = (idx + 1) & mask) {
+        auto& slot = interpolators.slots[idx];
+        if (slot.hash == hash && !strcmp(slot.interpolator->key, key)) return slot.interpolator;
     }
 
     //new interpolator
-    if (!interpolator) {
-        interpolator = tvg::malloc<LottieInterpolator*>(sizeof(LottieInterpolator));
-        interpolator->set(key, in, out);
-        comp->interpolators.push(interpolator);
-    }
+    auto interpolator = tvg::malloc<LottieInterpolator*>(sizeof(LottieInterpolator));
+    interpolator->set(key, in, out);
+    comp->interpolators.push(interpolator);
+    interpolators.slots[idx] = {hash, interpolator};
 
     return interpolator;
 }
 
 
 template<typename T>
-void LottieParser::parseKeyFrame(T& prop)
+void LottieParser::parseKeyFrame(T& frames)
 {
     Point inTangent, outTangent;
     const char* interpolatorKey = nullptr;
-    auto& frame = prop.newFrame();
+    auto& frame = frames.newFrame();
     auto interpolator = false;
 
     enterObject();
@@ -431,7 +511,7 @@ void LottieParser::parseKeyFrame(T& prop)
         } else if (KEY_AS("e")) {
             //current end frame and the next start frame is duplicated,
             //We propagate the end value to the next frame to avoid having duplicated values.
-            auto& frame2 = prop.nextFrame();
+            auto& frame2 = frames.nextFrame();
             getValue(frame2.value);
         } else if (parseTangent(key, frame)) {
             continue;
@@ -453,12 +533,13 @@ void LottieParser::parsePropertyInternal(T& prop)
         getValue(prop.value);
     //multi value property
     } else {
+        typename T::Frames frames;
         enterArray();
         while (nextArrayValue()) {
-            if (peekType() == kObjectType) parseKeyFrame(prop);  //keyframes value
+            if (peekType() == kObjectType) parseKeyFrame(frames);  //keyframes value
             else if (getValue(prop.value)) break; //multi value property with no keyframes
         }
-        prop.prepare();
+        prop.prepare(frames);
     }
 }
 
@@ -658,8 +739,10 @@ void LottieParser::getPathSet(LottiePathSet& path)
     while (auto key = nextObjectKey()) {
         if (KEY_AS("k")) {
             if (peekType() == kArrayType) {
+                LottiePathSet::Frames frames;
                 enterArray();
-                while (nextArrayValue()) parseKeyFrame(path);
+                while (nextArrayValue()) parseKeyFrame(frames);
+                path.prepare(frames);
             } else {
                 getValue(path.value);
             }
@@ -919,7 +1002,7 @@ void LottieParser::parseImage(LottieImage* image, const char* data, const char*
 }
 
 
-LottieObject* LottieParser::parseAsset()
+LottieObject* LottieParser::parseAsset(bool deferrable)
 {
     enterObject();
 
@@ -943,7 +1026,10 @@ LottieObject* LottieParser::parseAsset()
                 id = _int2str(getInt());
             }
         }
-        else if (KEY_AS("layers")) obj = parseLayers(comp->root);
+        else if (KEY_AS("layers")) {
+            if (deferrable) obj = deferLayers();
+            if (!obj) obj = parseLayers(comp->root);
+        }
         else if (KEY_AS("u")) subPath = getString();
         else if (KEY_AS("p")) data = getString();
         else if (KEY_AS("w")) width = getFloat();
@@ -1000,7 +1086,7 @@ void LottieParser::parseAssets()
 {
     enterArray();
     while (nextArrayValue()) {
-        auto asset = parseAsset();
+        auto asset = parseAsset(deferrable);
         if (asset) comp->assets.push(asset);
         else TVGERR("LOTTIE", "Invalid Asset!");
     }
@@ -1507,6 +1593,33 @@ LottieLayer* LottieParser::parseLayers(LottieLayer* root)
 }
 
 
+//skip the layers of the precomp asset, they are parsed when the asset shows up at first
+LottieLayer* LottieParser::deferLayers()
+{
+    if (peekType() != kArrayType) return nullptr;
+
+    Array<unsigned long> refs;
+    auto begin = getPos() - 1;  //'['
+    auto end = _scan(getPos(), expressions, refs);
+    if (!end) return nullptr;
+
+    auto precomp = new LottieLayer;
+    precomp->type = LottieLayer::Precomp;
+    precomp->comp = comp->root;
+    precomp->prepare();
+
+    comp->deferrals.push({precomp, uint32_t(begin - iss.head_), uint32_t(end - iss.head_), 0});
+    this->refs.push(refs);
+
+    //resume parsing after the layers
+    iss.src_ = end;
+    parseNext();
+    parseNext();
+
+    return precomp;
+}
+
+
 void LottieParser::postProcess(Array<LottieGlyph*>& glyphs)
 {
     //aggregate font characters
@@ -1522,6 +1635,13 @@ void LottieParser::postProcess(Array<LottieGlyph*>& glyphs)
             }
         }
     }
+
+    //the assets referenced by the deferred layers might be referenced by the others as well
+    ARRAY_FOREACH(p, refs) {
+        ARRAY_FOREACH(a, comp->assets) {
+            if ((*a)->id == *p && (*a)->type == LottieObject::Layer) static_cast<LottieLayer*>(*a)->shared = true;
+        }
+    }
 }
 
 
@@ -1695,3 +1815,17 @@ bool LottieParser::parse()
 
     return true;
 }
+
+
+bool LottieParser::parse(LottieLayer* asset)
+{
+    if (!parseNext() || !enterArray()) return false;
+
+    while (nextArrayValue()) {
+        asset->children.push(parseLayer(asset));
+    }
+
+    asset->LottieGroup::prepare(LottieObject::Layer);
+
+    return !Invalid();
+}
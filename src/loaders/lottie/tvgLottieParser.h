@@ -36,7 +36,13 @@ public:
         this->expressions = expressions;
     }
 
+    ~LottieParser()
+    {
+        tvg::free(interpolators.slots);
+    }
+
     bool parse();
+    bool parse(LottieLayer* asset);
     bool apply(LottieSlot* slot, bool byDefault);
     const char* sid(bool first = false);
     void captureSlots(const char* key);
@@ -46,12 +52,14 @@ public:
     const char* dirName = nullptr;       //base resource directory
     char* slots = nullptr;
     bool expressions = false;            //support expressions?
+    bool deferrable = false;             //the source data is available after the loading
 
 private:
     RGB24 getColor(const char *str);
     FillRule getFillRule();
     MaskMethod getMaskMethod(bool inversed);
     LottieInterpolator* getInterpolator(const char* key, Point& in, Point& out);
+    void indexInterpolators();
     LottieEffect* getEffect(int type);
     LottieExpression* getExpression(char* code, LottieComposition* comp, LottieLayer* layer, LottieObject* object, LottieProperty* property);
 
@@ -70,13 +78,13 @@ private:
 
     template<typename T> bool parseTangent(const char *key, LottieVectorFrame<T>& value);
     template<typename T> bool parseTangent(const char *key, LottieScalarFrame<T>& value);
-    template<typename T> void parseKeyFrame(T& prop);
+    template<typename T> void parseKeyFrame(T& frames);
     template<typename T> void parsePropertyInternal(T& prop);
     template<typename T> void parseProperty(T& prop, LottieObject* obj = nullptr);
     template<typename T> void parseSlotProperty(T& prop);
 
     LottieObject* parseObject();
-    LottieObject* parseAsset();
+    LottieObject* parseAsset(bool deferrable = false);
     void parseImage(LottieImage* image, const char* data, const char* subPath, bool embedded, float width, float height);
     LottieLayer* parseLayer(LottieLayer* precomp);
     LottieObject* parseGroup();
@@ -91,6 +99,7 @@ private:
     LottieRoundedCorner* parseRoundedCorner();
     LottieGradientFill* parseGradientFill();
     LottieLayer* parseLayers(LottieLayer* root);
+    LottieLayer* deferLayers();
     LottieMask* parseMask();
     LottieTrimpath* parseTrimpath();
     LottieRepeater* parseRepeater();
@@ -134,6 +143,17 @@ private:
         LottieLayer* layer = nullptr;
         LottieObject* parent = nullptr;
     } context;
+
+    //Hash index of the composition interpolators (open addressing)
+    struct {
+        struct Slot {
+            unsigned long hash;
+            LottieInterpolator* interpolator;
+        }* slots = nullptr;
+        uint32_t capacity = 0;
+    } interpolators;
+
+    Array<unsigned long> refs;  //the assets referenced by the deferred layers
 };
 
 #endif //_TVG_LOTTIE_PARSER_H_
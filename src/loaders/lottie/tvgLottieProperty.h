@@ -42,6 +42,7 @@ struct LottieProperty;
 #define DEFAULT_COND (!tween.active || !frames || (frames->count == 1))
 
 
+//a keyframe in parsing, the keyframes are packed into the property once the parsing is done
 template<typename T>
 struct LottieScalarFrame
 {
@@ -49,77 +50,282 @@ struct LottieScalarFrame
     float no;                   //frame number
     LottieInterpolator* interpolator;
     bool hold = false;           //do not interpolate.
+};
+
+
+template<typename T>
+struct LottieVectorFrame
+{
+    T value;                    //keyframe value
+    float no;                   //frame number
+    LottieInterpolator* interpolator;
+    T outTangent, inTangent;
+    bool hasTangent = false;
+    bool hold = false;
+};
+
 
-    T interpolate(LottieScalarFrame<T>* next, float frameNo)
+//the keyframes in the order of parsing
+template<typename Frame>
+struct LottieFrames : Array<Frame>
+{
+    Frame& newFrame()
     {
-        auto t = (frameNo - no) / (next->no - no);
-        if (interpolator) t = interpolator->progress(t);
+        if (this->count + 1 >= this->reserved) {
+            auto old = this->reserved;
+            this->grow(this->count + 2);
+            memset((void*)(this->data + old), 0x00, sizeof(Frame) * (this->reserved - old));
+        }
+        ++this->count;
+        return this->last();
+    }
+
+    Frame& nextFrame()
+    {
+        return this->data[this->count];
+    }
+};
+
+
+template<typename T>
+static inline bool _tangent(const LottieScalarFrame<T>& frame, Point& out, Point& in)
+{
+    return false;
+}
+
+
+template<typename T>
+static inline bool _tangent(const LottieVectorFrame<T>& frame, Point& out, Point& in)
+{
+    out = frame.outTangent;
+    in = frame.inTangent;
+    return frame.hasTangent;
+}
 
-        if (hold) {
-            if (t < 1.0f) return value;
-            else return next->value;
+
+//only the spatial values (points) have the tangents
+template<typename T>
+static inline T _curve(const T& from, TVG_UNUSED const T& to, TVG_UNUSED const Point* tangent, TVG_UNUSED float length, TVG_UNUSED float t)
+{
+    return from;
+}
+
+
+static inline Point _curve(const Point& from, const Point& to, const Point* tangent, float length, float t)
+{
+    Bezier bz = {from, from + tangent[0], to + tangent[1], to};
+    return bz.at(bz.atApprox(t * length, length));
+}
+
+
+template<typename T>
+static inline float _length(TVG_UNUSED const T& from, TVG_UNUSED const T& to, TVG_UNUSED const Point* tangent)
+{
+    return 0.0f;
+}
+
+
+static inline float _length(const Point& from, const Point& to, const Point* tangent)
+{
+    Bezier bz = {from, from + tangent[0], to + tangent[1], to};
+    return bz.lengthApprox();
+}
+
+
+static inline uintptr_t _align(uintptr_t p, uintptr_t alignment)
+{
+    return (p + alignment - 1) & ~(alignment - 1);
+}
+
+
+//the interpolator table of a property, mapped by the pointers in a single pass over the keyframes
+struct LottieInterpolatorTable
+{
+    struct Slot
+    {
+        LottieInterpolator* interpolator;
+        uint32_t idx;
+    };
+
+    Array<LottieInterpolator*> table;
+    Slot* slots;
+    uint32_t mask;
+    Slot local[16];     //enough for the most properties
+
+    LottieInterpolatorTable(uint32_t cnt)
+    {
+        uint32_t capacity = 16;
+        while (capacity < cnt * 2) capacity <<= 1;
+        if (capacity > 16) slots = tvg::calloc<Slot*>(capacity, sizeof(Slot));
+        else {
+            memset(local, 0x00, sizeof(local));
+            slots = local;
         }
-        return tvg::lerp(value, next->value, t);
+        mask = capacity - 1;
     }
 
-    float angle(LottieScalarFrame* next, float frameNo)
+    ~LottieInterpolatorTable()
     {
-        return 0.0f;
+        if (slots != local) tvg::free(slots);
     }
 
-    void prepare(TVG_UNUSED LottieScalarFrame* next)
+    //one-based index of the interpolator in the table, zero is linear
+    uint32_t index(LottieInterpolator* interpolator)
     {
+        if (!interpolator) return 0;
+
+        auto idx = uint32_t((uintptr_t(interpolator) >> 4) * 2654435761u) & mask;
+        for (; slots[idx].interpolator; idx = (idx + 1) & mask) {
+            if (slots[idx].interpolator == interpolator) return slots[idx].idx;
+        }
+        table.push(interpolator);
+        slots[idx] = {interpolator, table.count};
+        return table.count;
     }
 };
 
 
-template<typename T>
-struct LottieVectorFrame
+/* The keyframes of a property packed into a single block as the structure of arrays.
+   The frame numbers searched by the evaluation come first, then the values, the tangents
+   and the arc lengths of the spatial keyframes (if any), the interpolator indices and the flags.
+   The keyframes share their interpolators by the indices to the table of the property,
+   or refer to them directly if the property has more distinct easings than the indices can address. */
+template<typename Value>
+struct LottieKeyframes
 {
-    T value;                    //keyframe value
-    float no;                   //frame number
-    LottieInterpolator* interpolator;
-    T outTangent, inTangent;
-    float length;
-    bool hasTangent = false;
-    bool hold = false;
+    enum Flag : uint8_t {Hold = 1, Tangent = 2};
+
+    uint32_t count;                 //the number of the keyframes
+    uint16_t interpolatorCnt;       //the size of the interpolator table
+    bool spatial;                   //the tangents and the arc lengths are given
+    bool direct;                    //the keyframes have the interpolators instead of the indices
+
+    LottieInterpolator** interpolators() const { return (LottieInterpolator**)(this + 1); }
+    float* no() const { return (float*)(interpolators() + interpolatorCnt); }
+    Value* value() const { return (Value*)_align(uintptr_t(no() + count), alignof(Value)); }
+    Point* tangent() const { return (Point*)_align(uintptr_t(value() + count), alignof(Point)); }  //the out and in tangents by turns
+    float* length() const { return (float*)(tangent() + 2 * count); }
+    uint8_t* ease() const { return (uint8_t*)_align(spatial ? uintptr_t(length() + count) : uintptr_t(value() + count), easeSize()); }  //the indices (zero is linear) or the interpolators
+    uint8_t* flag() const { return ease() + count * easeSize(); }
 
-    T interpolate(LottieVectorFrame* next, float frameNo)
+    size_t easeSize() const
     {
-        auto t = (frameNo - no) / (next->no - no);
-        if (interpolator) t = interpolator->progress(t);
+        return direct ? sizeof(LottieInterpolator*) : sizeof(uint16_t);
+    }
 
-        if (hold) {
-            if (t < 1.0f) return value;
-            else return next->value;
-        }
+    LottieInterpolator* interpolator(uint32_t key) const
+    {
+        if (direct) return ((LottieInterpolator**)ease())[key];
+        if (auto idx = ((uint16_t*)ease())[key]) return interpolators()[idx - 1];
+        return nullptr;
+    }
 
-        if (hasTangent) {
-            Bezier bz = {value, value + outTangent, next->value + inTangent, next->value};
-            return bz.at(bz.atApprox(t * length, length));
-        } else {
-            return tvg::lerp(value, next->value, t);
+    size_t size() const
+    {
+        return uintptr_t(flag() + count) - uintptr_t(this);
+    }
+
+    bool hold(uint32_t key) const
+    {
+        return flag()[key] & Hold;
+    }
+
+    //the progress to the next keyframe
+    float progress(uint32_t key, float frameNo) const
+    {
+        auto no = this->no();
+        auto t = (frameNo - no[key]) / (no[key + 1] - no[key]);
+        if (auto interpolator = this->interpolator(key)) t = interpolator->progress(t);
+        return t;
+    }
+
+    Value interpolate(uint32_t key, float frameNo) const
+    {
+        auto t = progress(key, frameNo);
+        auto value = this->value() + key;
+
+        if (hold(key)) {
+            if (t < 1.0f) return value[0];
+            else return value[1];
         }
+        if (flag()[key] & Tangent) return _curve(value[0], value[1], tangent() + 2 * key, length()[key], t);
+        return tvg::lerp(value[0], value[1], t);
     }
 
-    float angle(LottieVectorFrame* next, float frameNo)
+    float angle(uint32_t key, float frameNo) const
     {
-        if (!hasTangent) {
-            Point dp = next->value - value;
+        auto value = this->value() + key;
+
+        if (!(flag()[key] & Tangent)) {
+            Point dp = value[1] - value[0];
             return rad2deg(tvg::atan2(dp.y, dp.x));
         }
 
-        auto t = (frameNo - no) / (next->no - no);
-        if (interpolator) t = interpolator->progress(t);
-        Bezier bz = {value, value + outTangent, next->value + inTangent, next->value};
+        auto t = progress(key, frameNo);
+        auto tangent = this->tangent() + 2 * key;
+        Bezier bz = {value[0], value[0] + tangent[0], value[1] + tangent[1], value[1]};
+        auto length = this->length()[key];
         t = bz.atApprox(t * length, length);
         return bz.angle(t >= 1.0f ? 0.99f : (t <= 0.0f ? 0.01f : t));
     }
 
-    void prepare(LottieVectorFrame* next)
+    LottieKeyframes* duplicate() const
     {
-        Bezier bz = {value, value + outTangent, next->value + inTangent, next->value};
-        length = bz.lengthApprox();
+        auto size = this->size();
+        auto dup = tvg::malloc<LottieKeyframes*>(size);
+        memcpy((void*)dup, (void*)this, size);
+        return dup;
+    }
+
+    //pack the parsed keyframes, the values are moved
+    template<typename Frame>
+    static LottieKeyframes* gen(const LottieFrames<Frame>& frames)
+    {
+        LottieInterpolatorTable table(frames.count);
+        Array<uint32_t> indices;
+        Point out, in;
+        alignas(16) LottieKeyframes header = {frames.count, 0, false, false};  //aligned as the malloc() block for its size
+
+        indices.reserve(frames.count);
+        ARRAY_FOREACH(p, frames) {
+            if (_tangent(*p, out, in)) header.spatial = true;
+            indices.push(table.index(p->interpolator));
+        }
+        if (table.table.count > UINT16_MAX) header.direct = true;
+        else header.interpolatorCnt = table.table.count;
+
+        auto keys = tvg::malloc<LottieKeyframes*>(header.size());
+        *keys = header;
+
+        if (keys->interpolatorCnt > 0) memcpy(keys->interpolators(), table.table.data, keys->interpolatorCnt * sizeof(LottieInterpolator*));
+
+        auto no = keys->no();
+        auto value = keys->value();
+        auto tangent = keys->tangent();
+        auto ease = keys->ease();
+        auto flag = keys->flag();
+
+        for (uint32_t i = 0; i < frames.count; ++i) {
+            auto& frame = frames[i];
+            no[i] = frame.no;
+            memcpy((void*)(value + i), (void*)&frame.value, sizeof(Value));
+            if (keys->direct) ((LottieInterpolator**)ease)[i] = frame.interpolator;
+            else ((uint16_t*)ease)[i] = indices[i];
+            flag[i] = frame.hold ? Hold : 0;
+            if (keys->spatial) {
+                if (_tangent(frame, tangent[2 * i], tangent[2 * i + 1])) flag[i] |= Tangent;
+                else tangent[2 * i] = tangent[2 * i + 1] = {0.0f, 0.0f};
+            }
+        }
+
+        //the arc lengths of the spatial segments
+        if (keys->spatial) {
+            auto length = keys->length();
+            for (uint32_t i = 0; i < frames.count; ++i) {
+                length[i] = (i + 1 < frames.count) ? _length(value[i], value[i + 1], tangent + 2 * i) : 0.0f;
+            }
+        }
+        return keys;
     }
 };
 
@@ -140,6 +346,8 @@ struct LottieExpression
     LottieObject* object;
     LottieProperty* property;
     Array<Writable> writables;
+    LottieExpressions* engine = nullptr;  //the expressions engine owning the script
+    uint32_t script = 0;       //compiled code by the expressions engine
     bool disabled = false;
 
     struct {
@@ -162,6 +370,7 @@ struct LottieExpression
 
     ~LottieExpression()
     {
+        LottieExpressions::discard(this);
         ARRAY_FOREACH(p, writables) {
             tvg::free(p->var);
         }
@@ -180,9 +389,36 @@ struct LottieExpression
         writables.push({tvg::duplicate(var), val});
         return true;
     }
+
+    size_t memory() const
+    {
+        auto size = sizeof(LottieExpression) + strlen(code) + 1 + writables.reserved * sizeof(Writable);
+        ARRAY_FOREACH(p, writables) size += strlen(p->var) + 1;
+        return size;
+    }
 };
 
 
+static inline size_t _memory(const PathSet& path)
+{
+    return path.ptsCnt * sizeof(Point) + path.cmdsCnt * sizeof(PathCommand);
+}
+
+
+static inline size_t _memory(const ColorStop& color, uint16_t count)
+{
+    auto size = color.data ? count * sizeof(Fill::ColorStop) : 0;
+    if (color.input) size += sizeof(Array<float>) + color.input->reserved * sizeof(float);
+    return size;
+}
+
+
+static inline size_t _memory(const TextDocument& doc)
+{
+    return (doc.text ? strlen(doc.text) + 1 : 0) + (doc.name ? strlen(doc.name) + 1 : 0);
+}
+
+
 //Property would have an either keyframes or single value.
 struct LottieProperty
 {
@@ -191,6 +427,11 @@ struct LottieProperty
     LottieExpression* exp = nullptr;
     Type type;
     uint8_t ix;  //property index
+    /* the last evaluated keyframe index, the playback proceeds forward usually.
+       The animations sharing the composition write it as well, so the properties are evaluated
+       only under the composition key, and a property is built by a single thread at a time
+       since the concurrently built layers never share their properties. */
+    uint32_t cursor = 0;
 
     LottieProperty(Type type = Type::Invalid) : type(type) {}
     virtual ~LottieProperty() {}
@@ -199,6 +440,21 @@ struct LottieProperty
     virtual uint32_t nearest(float frameNo) = 0;
     virtual float frameNo(int32_t key) = 0;
 
+    //the heap memory retained by this property, the keyframes and the expression
+    virtual size_t memory()
+    {
+        return exp ? exp->memory() : 0;
+    }
+
+    //the value doesn't change in the frame range [begin, end), the expressions could change it anytime.
+    bool constant(float begin, float end)
+    {
+        if (exp) return false;
+        auto cnt = frameCnt();
+        if (cnt <= 1) return true;
+        return frameNo(cnt - 1) <= begin || frameNo(0) >= end;
+    }
+
     bool copy(LottieProperty* rhs, bool shallow)
     {
         type = rhs->type;
@@ -246,13 +502,13 @@ static void _copy(PathSet* pathset, Array<PathCommand>& out)
 template<typename T>
 uint32_t _bsearch(T* frames, float frameNo)
 {
+    auto no = frames->no();
     int32_t low = 0;
     int32_t high = int32_t(frames->count) - 1;
 
     while (low <= high) {
         auto mid = low + (high - low) / 2;
-        auto frame = frames->data + mid;
-        if (frameNo < frame->no) high = mid - 1;
+        if (frameNo < no[mid]) high = mid - 1;
         else low = mid + 1;
     }
     if (high < low) low = high;
@@ -261,13 +517,28 @@ uint32_t _bsearch(T* frames, float frameNo)
 }
 
 
+//check the last or the next keyframe of the sequential playback before searching
+template<typename T>
+uint32_t _bsearch(T* frames, float frameNo, uint32_t& cursor)
+{
+    auto no = frames->no();
+    auto key = cursor;
+    if (key + 1 < frames->count && no[key] <= frameNo) {
+        if (frameNo < no[key + 1]) return key;
+        if (key + 2 < frames->count && frameNo < no[key + 2]) return (cursor = key + 1);
+    }
+    return (cursor = _bsearch(frames, frameNo));
+}
+
+
 template<typename T>
 uint32_t _nearest(T* frames, float frameNo)
 {
     if (frames) {
+        auto no = frames->no();
         auto key = _bsearch(frames, frameNo);
         if (key == frames->count - 1) return key;
-        return (fabsf(frames->data[key].no - frameNo) < fabsf(frames->data[key + 1].no - frameNo)) ? key : (key + 1);
+        return (fabsf(no[key] - frameNo) < fabsf(no[key + 1] - frameNo)) ? key : (key + 1);
     }
     return 0;
 }
@@ -279,7 +550,7 @@ float _frameNo(T* frames, int32_t key)
     if (!frames) return 0.0f;
     if (key < 0) key = 0;
     if (key >= (int32_t) frames->count) key = (int32_t)(frames->count - 1);
-    return (*frames)[key].no;
+    return frames->no()[key];
 }
 
 
@@ -289,28 +560,32 @@ float _loop(T* frames, float frameNo, LottieExpression* exp)
     if (!frames) return frameNo;
     if (exp->loop.mode == LottieExpression::LoopMode::None) return frameNo;
 
-    if (frameNo >= exp->loop.in || frameNo < frames->first().no || frameNo < frames->last().no) return frameNo;
+    auto no = frames->no();
+    auto first = no[0];
+    auto last = no[frames->count - 1];
 
-    frameNo -= frames->first().no;
+    if (frameNo >= exp->loop.in || frameNo < first || frameNo < last) return frameNo;
+
+    frameNo -= first;
 
     switch (exp->loop.mode) {
         case LottieExpression::LoopMode::InCycle: {
-            return fmodf(frameNo, frames->last().no - frames->first().no) + (*frames)[exp->loop.key].no;
+            return fmodf(frameNo, last - first) + no[exp->loop.key];
         }
         case LottieExpression::LoopMode::InPingPong: {
-            auto range = frames->last().no - (*frames)[exp->loop.key].no;
+            auto range = last - no[exp->loop.key];
             auto forward = (static_cast<int>(frameNo / range) % 2) == 0 ? true : false;
             frameNo = fmodf(frameNo, range);
-            return (forward ? frameNo : (range - frameNo)) + (*frames)[exp->loop.key].no;
+            return (forward ? frameNo : (range - frameNo)) + no[exp->loop.key];
         }
         case LottieExpression::LoopMode::OutCycle: {
-            return fmodf(frameNo, (*frames)[frames->count - 1 - exp->loop.key].no - frames->first().no) + frames->first().no;
+            return fmodf(frameNo, no[frames->count - 1 - exp->loop.key] - first) + first;
         }
         case LottieExpression::LoopMode::OutPingPong: {
-            auto range = (*frames)[frames->count - 1 - exp->loop.key].no - frames->first().no;
+            auto range = no[frames->count - 1 - exp->loop.key] - first;
             auto forward = (static_cast<int>(frameNo / range) % 2) == 0 ? true : false;
             frameNo = fmodf(frameNo, range);
-            return (forward ? frameNo : (range - frameNo)) + frames->first().no;
+            return (forward ? frameNo : (range - frameNo)) + first;
         }
         default: break;
     }
@@ -318,13 +593,14 @@ float _loop(T* frames, float frameNo, LottieExpression* exp)
 }
 
 
-template<typename Frame, typename Value, LottieProperty::Type PType = LottieProperty::Type::Invalid, bool Scalar = 1>
+template<typename Frame, typename Value, LottieProperty::Type PType = LottieProperty::Type::Invalid>
 struct LottieGenericProperty : LottieProperty
 {
-    using MyProperty = LottieGenericProperty<Frame, Value, PType, Scalar>;
+    using MyProperty = LottieGenericProperty<Frame, Value, PType>;
+    using Frames = LottieFrames<Frame>;
 
     //Property has an either keyframes or single value.
-    Array<Frame>* frames = nullptr;
+    LottieKeyframes<Value>* frames = nullptr;
     Value value;
 
     LottieGenericProperty(Value v) : LottieProperty(PType), value(v) {}
@@ -343,7 +619,7 @@ struct LottieGenericProperty : LottieProperty
 
     void release()
     {
-        delete(frames);
+        tvg::free(frames);
         frames = nullptr;
         if (exp) {
             delete(exp);
@@ -366,21 +642,9 @@ struct LottieGenericProperty : LottieProperty
         return _frameNo(frames, key);
     }
 
-    Frame& newFrame()
-    {
-        if (!frames) frames = new Array<Frame>;
-        if (frames->count + 1 >= frames->reserved) {
-            auto old = frames->reserved;
-            frames->grow(frames->count + 2);
-            memset((void*)(frames->data + old), 0x00, sizeof(Frame) * (frames->reserved - old));
-        }
-        ++frames->count;
-        return frames->last();
-    }
-
-    Frame& nextFrame()
+    size_t memory() override
     {
-        return (*frames)[frames->count];
+        return LottieProperty::memory() + (frames ? frames->size() : 0);
     }
 
     Value operator()(float frameNo, LottieExpressions* exps = nullptr)
@@ -393,12 +657,15 @@ struct LottieGenericProperty : LottieProperty
         }
 
         if (!frames) return value;
-        if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
-        if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
-        if (tvg::equal(frame->no, frameNo)) return frame->value;
-        return frame->interpolate(frame + 1, frameNo);
+        auto no = frames->no();
+        auto last = frames->count - 1;
+        if (last == 0 || frameNo <= no[0]) return frames->value()[0];
+        if (frameNo >= no[last]) return frames->value()[last];
+
+        auto key = _bsearch(frames, frameNo, cursor);
+        if (tvg::equal(no[key], frameNo)) return frames->value()[key];
+        return frames->interpolate(key, frameNo);
     }
 
     Value operator()(float frameNo, Tween& tween, LottieExpressions* exps)
@@ -416,8 +683,7 @@ struct LottieGenericProperty : LottieProperty
                 frames = rhs.frames;
                 rhs.frames = nullptr;
             } else {
-                frames = new Array<Frame>;
-                *frames = *rhs.frames;
+                frames = rhs.frames->duplicate();
             }
         } else {
             frames = nullptr;
@@ -429,14 +695,12 @@ struct LottieGenericProperty : LottieProperty
     {
         if (!frames || frames->count == 1) return 0;
 
-        if (frameNo <= frames->first().no) return frames->first().angle(frames->data + 1, frames->first().no);
-        if (frameNo >= frames->last().no) {
-            auto frame = frames->data + frames->count - 2;
-            return frame->angle(frame + 1, frames->last().no);
-        }
+        auto no = frames->no();
+        auto last = frames->count - 1;
+        if (frameNo <= no[0]) return frames->angle(0, no[0]);
+        if (frameNo >= no[last]) return frames->angle(last - 1, no[last]);
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
-        return frame->angle(frame + 1, frameNo);
+        return frames->angle(_bsearch(frames, frameNo, cursor), frameNo);
     }
 
     float angle(float frameNo, Tween& tween)
@@ -445,20 +709,18 @@ struct LottieGenericProperty : LottieProperty
         return tvg::lerp(angle(frameNo), angle(tween.frameNo), tween.progress);
     }
 
-    void prepare()
+    void prepare(Frames& frames)
     {
-        if (Scalar) return;
-        if (!frames || frames->count < 2) return;
-        for (auto frame = frames->begin() + 1; frame < frames->end(); ++frame) {
-            (frame - 1)->prepare(frame);
-        }
+        if (frames.count > 0) this->frames = LottieKeyframes<Value>::gen(frames);
     }
 };
 
 
 struct LottiePathSet : LottieProperty
 {
-    Array<LottieScalarFrame<PathSet>>* frames = nullptr;
+    using Frames = LottieFrames<LottieScalarFrame<PathSet>>;
+
+    LottieKeyframes<PathSet>* frames = nullptr;
     PathSet value;
 
     LottiePathSet() : LottieProperty(LottieProperty::Type::PathSet) {}
@@ -480,11 +742,11 @@ struct LottiePathSet : LottieProperty
 
         if (!frames) return;
 
-        ARRAY_FOREACH(p, *frames) {
-            tvg::free((*p).value.cmds);
-            tvg::free((*p).value.pts);
+        auto path = frames->value();
+        for (uint32_t i = 0; i < frames->count; ++i, ++path) {
+            tvg::free(path->cmds);
+            tvg::free(path->pts);
         }
-        tvg::free(frames->data);
         tvg::free(frames);
     }
 
@@ -503,54 +765,59 @@ struct LottiePathSet : LottieProperty
         return _frameNo(frames, key);
     }
 
-    LottieScalarFrame<PathSet>& newFrame()
+    size_t memory() override
     {
-        if (!frames) {
-            frames = tvg::calloc<Array<LottieScalarFrame<PathSet>>*>(1, sizeof(Array<LottieScalarFrame<PathSet>>));
+        auto size = LottieProperty::memory() + _memory(value);
+        if (frames) {
+            size += frames->size();
+            auto path = frames->value();
+            for (uint32_t i = 0; i < frames->count; ++i) size += _memory(path[i]);
         }
-        if (frames->count + 1 >= frames->reserved) {
-            auto old = frames->reserved;
-            frames->grow(frames->count + 2);
-            memset((void*)(frames->data + old), 0x00, sizeof(LottieScalarFrame<PathSet>) * (frames->reserved - old));
-        }
-        ++frames->count;
-        return frames->last();
+        return size;
     }
 
-    LottieScalarFrame<PathSet>& nextFrame()
+    void prepare(Frames& frames)
     {
-        return (*frames)[frames->count];
+        if (frames.count > 0) this->frames = LottieKeyframes<PathSet>::gen(frames);
     }
 
-    //return false means requiring the interpolation
-    bool dispatch(float frameNo, PathSet*& path, LottieScalarFrame<PathSet>*& frame, float& t)
+    //return false means requiring the interpolation from the path to the next one
+    bool dispatch(float frameNo, PathSet*& path, float& t)
     {
-        if (!frames) path = &value;
-        else if (frames->count == 1 || frameNo <= frames->first().no) path = &frames->first().value;
-        else if (frameNo >= frames->last().no) path = &frames->last().value;
-        else {
-            frame = frames->data + _bsearch(frames, frameNo);
-            if (tvg::equal(frame->no, frameNo)) path = &frame->value;
-            else if (frame->value.ptsCnt != (frame + 1)->value.ptsCnt) {
-                path = &frame->value;
-            } else {
-                t = (frameNo - frame->no) / ((frame + 1)->no - frame->no);
-                if (frame->interpolator) t = frame->interpolator->progress(t);
-                if (frame->hold) path = &(frame + ((t < 1.0f) ? 0 : 1))->value;
-                else return false;
-            }
+        if (!frames) {
+            path = &value;
+            return true;
         }
+
+        auto no = frames->no();
+        auto last = frames->count - 1;
+        path = frames->value();
+
+        if (last == 0 || frameNo <= no[0]) return true;
+        if (frameNo >= no[last]) {
+            path += last;
+            return true;
+        }
+
+        auto key = _bsearch(frames, frameNo, cursor);
+        path += key;
+        if (tvg::equal(no[key], frameNo) || path->ptsCnt != (path + 1)->ptsCnt) return true;
+
+        t = frames->progress(key, frameNo);
+        if (!frames->hold(key)) return false;
+        if (t >= 1.0f) ++path;
         return true;
     }
 
-    bool modifiedPath(float frameNo, RenderPath& out, Matrix* transform, LottieModifier* modifier)
+    bool modifiedPath(float frameNo, RenderPath& out, Matrix* transform, LottieModifier* modifier, LottieModifierCache* cache)
     {
         PathSet* path;
-        LottieScalarFrame<PathSet>* frame;
         RenderPath temp;
         float t;
 
-        if (dispatch(frameNo, path, frame, t)) {
+        if (dispatch(frameNo, path, t)) {
+            //a steady path: the modified output could be reused
+            if (cache) return modifier->cachedPath(*cache, path->cmds, path->cmdsCnt, path->pts, path->ptsCnt, transform, out);
             if (modifier) return modifier->modifyPath(path->cmds, path->cmdsCnt, path->pts, path->ptsCnt, transform, out);
             _copy(path, out.cmds);
             _copy(path, out.pts, transform);
@@ -558,17 +825,17 @@ struct LottiePathSet : LottieProperty
         }
 
         //interpolate 2 frames
-        auto s = frame->value.pts;
-        auto e = (frame + 1)->value.pts;
-        auto interpPts = tvg::malloc<Point*>(frame->value.ptsCnt * sizeof(Point));
+        auto s = path->pts;
+        auto e = (path + 1)->pts;
+        auto interpPts = tvg::malloc<Point*>(path->ptsCnt * sizeof(Point));
         auto p = interpPts;
 
-        for (auto i = 0; i < frame->value.ptsCnt; ++i, ++s, ++e, ++p) {
+        for (auto i = 0; i < path->ptsCnt; ++i, ++s, ++e, ++p) {
             *p = tvg::lerp(*s, *e, t);
             if (transform) *p *= *transform;
         }
 
-        if (modifier) modifier->modifyPath(frame->value.cmds, frame->value.cmdsCnt, interpPts, frame->value.ptsCnt, nullptr, out);
+        if (modifier) modifier->modifyPath(path->cmds, path->cmdsCnt, interpPts, path->ptsCnt, nullptr, out);
 
         tvg::free(interpPts);
 
@@ -578,25 +845,24 @@ struct LottiePathSet : LottieProperty
     bool defaultPath(float frameNo, RenderPath& out, Matrix* transform)
     {
         PathSet* path;
-        LottieScalarFrame<PathSet>* frame;
         float t;
 
-        if (dispatch(frameNo, path, frame, t)) {
+        if (dispatch(frameNo, path, t)) {
             _copy(path, out.cmds);
             _copy(path, out.pts, transform);
             return true;
         }
 
         //interpolate 2 frames
-        auto s = frame->value.pts;
-        auto e = (frame + 1)->value.pts;
+        auto s = path->pts;
+        auto e = (path + 1)->pts;
 
-        for (auto i = 0; i < frame->value.ptsCnt; ++i, ++s, ++e) {
+        for (auto i = 0; i < path->ptsCnt; ++i, ++s, ++e) {
             auto pt = tvg::lerp(*s, *e, t);
             if (transform) pt *= *transform;
             out.pts.push(pt);
         }
-        _copy(&frame->value, out.cmds);
+        _copy(path, out.cmds);
         return true;
     }
 
@@ -621,7 +887,7 @@ struct LottiePathSet : LottieProperty
         return modifier->modifyPath(to.cmds.data, to.cmds.count, to.pts.data, to.pts.count, transform, out);
     }
 
-    bool operator()(float frameNo, RenderPath& out, Matrix* transform, LottieExpressions* exps, LottieModifier* modifier = nullptr)
+    bool operator()(float frameNo, RenderPath& out, Matrix* transform, LottieExpressions* exps, LottieModifier* modifier = nullptr, LottieModifierCache* cache = nullptr)
     {
         //overriding with expressions
         if (exps && exp) {
@@ -629,13 +895,13 @@ struct LottiePathSet : LottieProperty
             if (exps->result<LottiePathSet>(frameNo, out, transform, modifier, exp)) return true;
         }
 
-        if (modifier) return modifiedPath(frameNo, out, transform, modifier);
+        if (modifier) return modifiedPath(frameNo, out, transform, modifier, cache);
         else return defaultPath(frameNo, out, transform);
     }
 
-    bool operator()(float frameNo, RenderPath& out, Matrix* transform, Tween& tween, LottieExpressions* exps, LottieModifier* modifier = nullptr)
+    bool operator()(float frameNo, RenderPath& out, Matrix* transform, Tween& tween, LottieExpressions* exps, LottieModifier* modifier = nullptr, LottieModifierCache* cache = nullptr)
     {
-        if (DEFAULT_COND) return operator()(frameNo, out, transform, exps, modifier);
+        if (DEFAULT_COND) return operator()(frameNo, out, transform, exps, modifier, cache);
         return tweening(frameNo, out, transform, modifier, tween, exps);
     }
 };
@@ -643,7 +909,9 @@ struct LottiePathSet : LottieProperty
 
 struct LottieColorStop : LottieProperty
 {
-    Array<LottieScalarFrame<ColorStop>>* frames = nullptr;
+    using Frames = LottieFrames<LottieScalarFrame<ColorStop>>;
+
+    LottieKeyframes<ColorStop>* frames = nullptr;
     ColorStop value;
     uint16_t count = 0;     //colorstop count
     bool populated = false;
@@ -674,10 +942,10 @@ struct LottieColorStop : LottieProperty
 
         if (!frames) return;
 
-        ARRAY_FOREACH(p, *frames) {
-            tvg::free((*p).value.data);
+        auto color = frames->value();
+        for (uint32_t i = 0; i < frames->count; ++i, ++color) {
+            tvg::free(color->data);
         }
-        tvg::free(frames->data);
         tvg::free(frames);
         frames = nullptr;
     }
@@ -697,29 +965,21 @@ struct LottieColorStop : LottieProperty
         return _frameNo(frames, key);
     }
 
-    LottieScalarFrame<ColorStop>& newFrame()
+    size_t memory() override
     {
-        if (!frames) {
-            frames = tvg::calloc<Array<LottieScalarFrame<ColorStop>>*>(1, sizeof(Array<LottieScalarFrame<ColorStop>>));
+        auto size = LottieProperty::memory() + _memory(value, count);
+        if (frames) {
+            size += frames->size();
+            auto color = frames->value();
+            for (uint32_t i = 0; i < frames->count; ++i) size += _memory(color[i], count);
         }
-        if (frames->count + 1 >= frames->reserved) {
-            auto old = frames->reserved;
-            frames->grow(frames->count + 2);
-            memset((void*)(frames->data + old), 0x00, sizeof(LottieScalarFrame<ColorStop>) * (frames->reserved - old));
-        }
-        ++frames->count;
-        return frames->last();
-    }
-
-    LottieScalarFrame<ColorStop>& nextFrame()
-    {
-        return (*frames)[frames->count];
+        return size;
     }
 
     Result tweening(float frameNo, Fill* fill, Tween& tween, LottieExpressions* exps)
     {
-        auto frame = frames->data + _bsearch(frames, frameNo);
-        if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
+        auto key = _bsearch(frames, frameNo, cursor);
+        if (tvg::equal(frames->no()[key], frameNo)) return fill->colorStops(frames->value()[key].data, count);
 
         //from
         operator()(frameNo, fill, exps);
@@ -758,26 +1018,26 @@ struct LottieColorStop : LottieProperty
 
         if (!frames) return fill->colorStops(value.data, count);
 
-        if (frames->count == 1 || frameNo <= frames->first().no) {
-            return fill->colorStops(frames->first().value.data, count);
-        }
+        auto no = frames->no();
+        auto color = frames->value();
+        auto last = frames->count - 1;
 
-        if (frameNo >= frames->last().no) return fill->colorStops(frames->last().value.data, count);
+        if (last == 0 || frameNo <= no[0]) return fill->colorStops(color[0].data, count);
+        if (frameNo >= no[last]) return fill->colorStops(color[last].data, count);
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
-        if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
+        auto key = _bsearch(frames, frameNo, cursor);
+        if (tvg::equal(no[key], frameNo)) return fill->colorStops(color[key].data, count);
 
         //interpolate
-        auto t = (frameNo - frame->no) / ((frame + 1)->no - frame->no);
-        if (frame->interpolator) t = frame->interpolator->progress(t);
+        auto t = frames->progress(key, frameNo);
 
-        if (frame->hold) {
-            if (t < 1.0f) fill->colorStops(frame->value.data, count);
-            else fill->colorStops((frame + 1)->value.data, count);
+        if (frames->hold(key)) {
+            if (t < 1.0f) fill->colorStops(color[key].data, count);
+            else fill->colorStops(color[key + 1].data, count);
         }
 
-        auto s = frame->value.data;
-        auto e = (frame + 1)->value.data;
+        auto s = color[key].data;
+        auto e = color[key + 1].data;
 
         Array<Fill::ColorStop> result;
 
@@ -807,8 +1067,7 @@ struct LottieColorStop : LottieProperty
                 frames = rhs.frames;
                 rhs.frames = nullptr;
             } else {
-                frames = new Array<LottieScalarFrame<ColorStop>>;
-                *frames = *rhs.frames;
+                frames = rhs.frames->duplicate();
             }
         } else {
             frames = nullptr;
@@ -819,13 +1078,18 @@ struct LottieColorStop : LottieProperty
         count = rhs.count;
     }
 
-    void prepare() {}
+    void prepare(Frames& frames)
+    {
+        if (frames.count > 0) this->frames = LottieKeyframes<ColorStop>::gen(frames);
+    }
 };
 
 
 struct LottieTextDoc : LottieProperty
 {
-    Array<LottieScalarFrame<TextDocument>>* frames = nullptr;
+    using Frames = LottieFrames<LottieScalarFrame<TextDocument>>;
+
+    LottieKeyframes<TextDocument>* frames = nullptr;
     TextDocument value;
 
     LottieTextDoc() : LottieProperty(LottieProperty::Type::TextDoc) {}
@@ -858,11 +1122,12 @@ struct LottieTextDoc : LottieProperty
 
         if (!frames) return;
 
-        ARRAY_FOREACH(p, *frames) {
-            tvg::free((*p).value.text);
-            tvg::free((*p).value.name);
+        auto doc = frames->value();
+        for (uint32_t i = 0; i < frames->count; ++i, ++doc) {
+            tvg::free(doc->text);
+            tvg::free(doc->name);
         }
-        delete(frames);
+        tvg::free(frames);
         frames = nullptr;
     }
 
@@ -881,31 +1146,27 @@ struct LottieTextDoc : LottieProperty
         return _frameNo(frames, key);
     }
 
-    LottieScalarFrame<TextDocument>& newFrame()
+    size_t memory() override
     {
-        if (!frames) frames = new Array<LottieScalarFrame<TextDocument>>;
-        if (frames->count + 1 >= frames->reserved) {
-            auto old = frames->reserved;
-            frames->grow(frames->count + 2);
-            memset((void*)(frames->data + old), 0x00, sizeof(LottieScalarFrame<TextDocument>) * (frames->reserved - old));
+        auto size = LottieProperty::memory() + _memory(value);
+        if (frames) {
+            size += frames->size();
+            auto doc = frames->value();
+            for (uint32_t i = 0; i < frames->count; ++i) size += _memory(doc[i]);
         }
-        ++frames->count;
-        return frames->last();
-    }
-
-    LottieScalarFrame<TextDocument>& nextFrame()
-    {
-        return (*frames)[frames->count];
+        return size;
     }
 
     TextDocument& operator()(float frameNo)
     {
         if (!frames) return value;
-        if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
-        if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
-        return frame->value;
+        auto no = frames->no();
+        auto last = frames->count - 1;
+        if (last == 0 || frameNo <= no[0]) return frames->value()[0];
+        if (frameNo >= no[last]) return frames->value()[last];
+
+        return frames->value()[_bsearch(frames, frameNo, cursor)];
     }
 
     TextDocument& operator()(float frameNo, LottieExpressions* exps)
@@ -930,8 +1191,7 @@ struct LottieTextDoc : LottieProperty
                 frames = rhs.frames;
                 rhs.frames = nullptr;
             } else {
-                frames = new Array<LottieScalarFrame<TextDocument>>;
-                *frames = *rhs.frames;
+                frames = rhs.frames->duplicate();
             }
         } else {
             frames = nullptr;
@@ -941,7 +1201,10 @@ struct LottieTextDoc : LottieProperty
         }
     }
 
-    void prepare() {}
+    void prepare(Frames& frames)
+    {
+        if (frames.count > 0) this->frames = LottieKeyframes<TextDocument>::gen(frames);
+    }
 };
 
 
@@ -981,6 +1244,13 @@ struct LottieBitmap : LottieProperty
     uint32_t nearest(float frameNo) override { return 0; }
     float frameNo(int32_t key) override { return 0; }
 
+    size_t memory() override
+    {
+        auto ret = LottieProperty::memory() + (mimeType ? strlen(mimeType) + 1 : 0);
+        if (size > 0) return ret + size;   //the decoded data
+        return ret + (path ? strlen(path) + 1 : 0);
+    }
+
     void copy(LottieBitmap& rhs, bool shallow = true)
     {
         if (LottieProperty::copy(&rhs, shallow)) return;
@@ -1005,7 +1275,7 @@ struct LottieBitmap : LottieProperty
 using LottieFloat = LottieGenericProperty<LottieScalarFrame<float>, float, LottieProperty::Type::Float>;
 using LottieInteger = LottieGenericProperty<LottieScalarFrame<int8_t>, int8_t, LottieProperty::Type::Integer>;
 using LottieScalar = LottieGenericProperty<LottieScalarFrame<Point>, Point, LottieProperty::Type::Scalar>;
-using LottieVector = LottieGenericProperty<LottieVectorFrame<Point>, Point, LottieProperty::Type::Vector, 0>;
+using LottieVector = LottieGenericProperty<LottieVectorFrame<Point>, Point, LottieProperty::Type::Vector>;
 using LottieColor = LottieGenericProperty<LottieScalarFrame<RGB24>, RGB24, LottieProperty::Type::Color>;
 using LottieOpacity = LottieGenericProperty<LottieScalarFrame<uint8_t>, uint8_t, LottieProperty::Type::Opacity>;
 
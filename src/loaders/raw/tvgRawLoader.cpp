@@ -65,6 +65,13 @@ bool RawLoader::open(const uint32_t* data, uint32_t w, uint32_t h, ColorSpace cs
 }
 
 
+void RawLoader::memory(RenderMemory& out)
+{
+    //the user data is not retained by this loader
+    if (copy) ImageLoader::memory(out);
+}
+
+
 bool RawLoader::read()
 {
     LoadModule::read();
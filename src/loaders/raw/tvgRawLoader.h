@@ -34,6 +34,7 @@ public:
     using LoadModule::open;
     bool open(const uint32_t* data, uint32_t w, uint32_t h, ColorSpace cs, bool copy);
     bool read() override;
+    void memory(RenderMemory& out) override;
 };
 
 
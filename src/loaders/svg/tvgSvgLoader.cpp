@@ -4079,6 +4079,13 @@ bool SvgLoader::close()
 }
 
 
+void SvgLoader::memory(RenderMemory& out)
+{
+    //the file data or the copied one
+    if (copy || !filePath.empty()) out[MemoryType::Resource] += size;
+}
+
+
 Paint* SvgLoader::paint()
 {
     this->done();
@@ -47,6 +47,7 @@ public:
     bool resize(Paint* paint, float w, float h) override;
     bool read() override;
     bool close() override;
+    void memory(RenderMemory& out) override;
 
     Paint* paint() override;
 
@@ -276,6 +276,13 @@ bool TtfLoader::open(const char* data, uint32_t size, TVG_UNUSED const char* rpa
 }
 
 
+void TtfLoader::memory(RenderMemory& out)
+{
+    //only the copied data, neither the user data nor the mapped file
+    if (freeData) out[MemoryType::Resource] += reader.size;
+}
+
+
 bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out)
 {
     if (!text) return false;
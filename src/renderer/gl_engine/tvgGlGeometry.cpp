@@ -29,11 +29,9 @@
 bool GlGeometry::tesselate(const RenderShape& rshape, RenderUpdateFlag flag)
 {
     const RenderPath* path = nullptr;
-    RenderPath trimmedPath;
     if (rshape.trimpath()) {
-        if (!rshape.stroke->trim.trim(rshape.path, trimmedPath)) return true;
-        path = &trimmedPath;
-    } else path = &rshape.path;
+        if (!(path = rshape.trimmedPath())) return true;
+    } else path = &*rshape.path;
 
     if (flag & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient | RenderUpdateFlag::Transform | RenderUpdateFlag::Path)) {
         fill.clear();
@@ -856,11 +856,11 @@ void Tessellator::tessellate(const Array<const RenderShape*> &shapes)
     fillRule = FillRule::NonZero;
 
     for (uint32_t i = 0; i < shapes.count; i++) {
-        RenderPath trimmedPath;
         if (shapes[i]->trimpath()) {
-            if (!shapes[i]->stroke->trim.trim(shapes[i]->path, trimmedPath)) continue;
-            visitShape(trimmedPath);
-        } else visitShape(shapes[i]->path);
+            auto trimmedPath = shapes[i]->trimmedPath();
+            if (!trimmedPath) continue;
+            visitShape(*trimmedPath);
+        } else visitShape(*shapes[i]->path);
     }
 
     buildMesh();
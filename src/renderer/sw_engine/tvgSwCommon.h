@@ -110,6 +110,11 @@ struct SwOutline
     Array<uint8_t> types;           //curve type
     Array<bool> closed;             //opened or closed path?
     FillRule fillRule;
+
+    size_t memory() const
+    {
+        return pts.reserved * sizeof(SwPoint) + cntrs.reserved * sizeof(uint32_t) + types.reserved * sizeof(uint8_t) + closed.reserved * sizeof(bool);
+    }
 };
 
 struct SwSpan
@@ -133,6 +138,11 @@ struct SwRle
         return !invalid();
     }
 
+    size_t memory() const
+    {
+        return sizeof(SwRle) + spans.reserved * sizeof(SwSpan);
+    }
+
     uint32_t size() const { return spans.count; }
     SwSpan* data() const { return spans.data; }
 };
@@ -217,10 +227,24 @@ struct SwShape
     SwRle* rle = nullptr;
     SwRle* strokeRle = nullptr;
     RenderRegion bbox;           //Keep it boundary without stroke region. Using for optimal filling.
+    RenderRegion strokeBox;      //Keep the stroke region for the partial updates.
 
     bool fastTrack = false;   //Fast Track: axis-aligned rectangle without any clips?
 };
 
+struct SwInstance
+{
+    SwShape* shape = nullptr;    //unique geometry, not a translation of the base instance
+    SwRle* rle = nullptr;        //spans of the translated base outline
+    SwRle* strokeRle = nullptr;
+    RenderRegion bbox;           //fill region
+    RenderRegion renderBox;      //fill + stroke region
+    Matrix transform;
+    SwPoint offset;              //translation from the base instance
+    uint8_t opacity;
+    bool shared = false;         //draw the base instance spans with the offset
+};
+
 struct SwImage
 {
     SwOutline*   outline = nullptr;
@@ -254,6 +278,7 @@ struct SwSurface : RenderSurface
     SwBlender blender = nullptr;          //blender (optional)
     SwCompositor* compositor = nullptr;   //compositor (optional)
     BlendMethod blendMethod = BlendMethod::Normal;
+    uint8_t quality = FullQuality;        //the quality level of the tasks, lowered by the frame budget
 
     SwAlpha alpha(MaskMethod method)
     {
@@ -272,6 +297,7 @@ struct SwSurface : RenderSurface
         blender = rhs->blender;
         compositor = rhs->compositor;
         blendMethod = rhs->blendMethod;
+        quality = rhs->quality;
      }
 };
 
@@ -508,7 +534,10 @@ bool shapePrepared(const SwShape* shape);
 bool shapeGenRle(SwShape* shape, const RenderShape* rshape, bool antiAlias);
 void shapeDelOutline(SwShape* shape, SwMpool* mpool, uint32_t tid);
 void shapeResetStroke(SwShape* shape, const RenderShape* rshape, const Matrix& transform);
-bool shapeGenStrokeRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid);
+bool shapeGenStrokeRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, SwOutline* cache = nullptr);
+void shapeCacheOutline(const SwShape* shape, SwOutline* cache);
+bool shapeGenInstance(SwInstance* inst, const SwShape* base, const SwOutline* outline, const SwOutline* strokeOutline, const RenderRegion& clipBox, SwMpool* mpool, unsigned tid, bool antiAlias);
+void shapeFreeInstance(SwInstance* inst);
 void shapeFree(SwShape* shape);
 void shapeDelStroke(SwShape* shape);
 bool shapeGenFillColors(SwShape* shape, const Fill* fill, const Matrix& transform, SwSurface* surface, uint8_t opacity, bool ctable);
@@ -517,6 +546,7 @@ void shapeResetFill(SwShape* shape);
 void shapeResetStrokeFill(SwShape* shape);
 void shapeDelFill(SwShape* shape);
 void shapeDelStrokeFill(SwShape* shape);
+void shapeMemory(const SwShape* shape, RenderMemory& out);
 
 void strokeReset(SwStroke* stroke, const RenderShape* shape, const Matrix& transform);
 bool strokeParseOutline(SwStroke* stroke, const SwOutline& outline);
@@ -533,6 +563,7 @@ bool fillGenColorTable(SwFill* fill, const Fill* fdata, const Matrix& transform,
 const Fill::ColorStop* fillFetchSolid(const SwFill* fill, const Fill* fdata);
 void fillReset(SwFill* fill);
 void fillFree(SwFill* fill);
+size_t fillMemory(const SwFill* fill);
 
 //OPTIMIZE_ME: Skip the function pointer access
 void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask maskOp, uint8_t opacity);                                   //composite masking ver.
@@ -549,6 +580,7 @@ void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
 
 SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, bool antiAlias);
 SwRle* rleRender(const RenderRegion* bbox);
+SwRle* rleTranslate(SwRle* rle, const SwRle* src, int32_t x, int32_t y, const RenderRegion& clip);
 void rleFree(SwRle* rle);
 void rleReset(SwRle* rle);
 void rleMerge(SwRle* rle, SwRle* clip1, SwRle* clip2);
@@ -558,6 +590,7 @@ bool rleClip(SwRle* rle, const RenderRegion* clip);
 SwMpool* mpoolInit(uint32_t threads);
 bool mpoolTerm(SwMpool* mpool);
 bool mpoolClear(SwMpool* mpool);
+size_t mpoolMemory(const SwMpool* mpool);
 SwOutline* mpoolReqOutline(SwMpool* mpool, unsigned idx);
 void mpoolRetOutline(SwMpool* mpool, unsigned idx);
 SwOutline* mpoolReqStrokeOutline(SwMpool* mpool, unsigned idx);
@@ -588,10 +621,10 @@ uint32_t rasterUnpremultiply(uint32_t data);
 
 bool effectGaussianBlur(SwCompositor* cmp, SwSurface* surface, const RenderEffectGaussianBlur* params);
 bool effectGaussianBlurRegion(RenderEffectGaussianBlur* effect);
-void effectGaussianBlurUpdate(RenderEffectGaussianBlur* effect, const Matrix& transform);
+void effectGaussianBlurUpdate(RenderEffectGaussianBlur* effect, const Matrix& transform, bool coarse);
 bool effectDropShadow(SwCompositor* cmp, SwSurface* surfaces[2], const RenderEffectDropShadow* params, bool direct);
 bool effectDropShadowRegion(RenderEffectDropShadow* effect);
-void effectDropShadowUpdate(RenderEffectDropShadow* effect, const Matrix& transform);
+void effectDropShadowUpdate(RenderEffectDropShadow* effect, const Matrix& transform, bool coarse);
 void effectFillUpdate(RenderEffectFill* effect);
 bool effectFill(SwCompositor* cmp, const RenderEffectFill* params, bool direct);
 void effectTintUpdate(RenderEffectTint* effect);
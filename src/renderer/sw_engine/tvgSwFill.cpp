@@ -847,3 +847,10 @@ void fillFree(SwFill* fill)
 
     tvg::free(fill);
 }
+
+
+size_t fillMemory(const SwFill* fill)
+{
+    if (!fill) return 0;
+    return sizeof(SwFill) + (fill->ctable ? GRADIENT_STOP_SIZE * sizeof(uint32_t) : 0);
+}
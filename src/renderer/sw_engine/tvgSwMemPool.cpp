@@ -114,6 +114,20 @@ bool mpoolClear(SwMpool* mpool)
 }
 
 
+size_t mpoolMemory(const SwMpool* mpool)
+{
+    if (!mpool) return 0;
+
+    auto size = sizeof(SwMpool) + sizeof(SwOutline) * mpool->allocSize * 3;
+
+    for (unsigned i = 0; i < mpool->allocSize; ++i) {
+        size += mpool->outline[i].memory() + mpool->strokeOutline[i].memory() + mpool->dashOutline[i].memory();
+    }
+
+    return size;
+}
+
+
 bool mpoolTerm(SwMpool* mpool)
 {
     if (!mpool) return false;
@@ -109,12 +109,15 @@ static void _gaussianFilter(uint8_t* dst, uint8_t* src, int32_t stride, int32_t
 
 
 //Fast Almost-Gaussian Filtering Method by Peter Kovesi
-static int _gaussianInit(SwGaussianBlur* data, float sigma, int quality)
+static int _gaussianInit(SwGaussianBlur* data, float sigma, int quality, bool coarse)
 {
     const auto MAX_LEVEL = SwGaussianBlur::MAX_LEVEL;
 
     if (tvg::zero(sigma)) return 0;
 
+    //the fewer box passes in the lowered quality
+    if (coarse) quality = (quality + 1) / 2;
+
     data->level = int(SwGaussianBlur::MAX_LEVEL * ((quality - 1) * 0.01f)) + 1;
 
     //compute box kernel sizes
@@ -153,14 +156,14 @@ bool effectGaussianBlurRegion(RenderEffectGaussianBlur* params)
 }
 
 
-void effectGaussianBlurUpdate(RenderEffectGaussianBlur* params, const Matrix& transform)
+void effectGaussianBlurUpdate(RenderEffectGaussianBlur* params, const Matrix& transform, bool coarse)
 {
     if (!params->rd) params->rd = tvg::malloc<SwGaussianBlur*>(sizeof(SwGaussianBlur));
     auto rd = static_cast<SwGaussianBlur*>(params->rd);
 
     //compute box kernel sizes
     auto scale = sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12);
-    rd->extends = _gaussianInit(rd, std::pow(params->sigma * scale, 2), params->quality);
+    rd->extends = _gaussianInit(rd, std::pow(params->sigma * scale, 2), params->quality, coarse);
 
     //invalid
     if (rd->extends == 0) {
@@ -312,14 +315,14 @@ bool effectDropShadowRegion(RenderEffectDropShadow* params)
 }
 
 
-void effectDropShadowUpdate(RenderEffectDropShadow* params, const Matrix& transform)
+void effectDropShadowUpdate(RenderEffectDropShadow* params, const Matrix& transform, bool coarse)
 {
     if (!params->rd) params->rd = tvg::malloc<SwDropShadow*>(sizeof(SwDropShadow));
     auto rd = static_cast<SwDropShadow*>(params->rd);
 
     //compute box kernel sizes
     auto scale = sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12);
-    rd->extends = _gaussianInit(rd, std::pow(params->sigma * scale, 2), params->quality);
+    rd->extends = _gaussianInit(rd, std::pow(params->sigma * scale, 2), params->quality, coarse);
 
     //invalid
     if (rd->extends == 0 || params->color[3] == 0) {
@@ -693,8 +693,8 @@ static void _apply(SwSurface* surface, AASpans* aaSpans)
             pix = *(dst + (line->x[1] < (int32_t)(surface->w - 1) ? 1 : 0));
             pos = line->length[1];
 
-            //exceptional handling. out of memory bound.
-            if (dst - pos < surface->buf32) --pos;
+            //exceptional handling. out of the line bound.
+            if (pos > line->x[1]) pos = line->x[1];
 
             while (pos > 0) {
                 *dst = INTERPOLATE(*dst, pix, 255 - (line->coverage[1] * pos));
@@ -35,6 +35,7 @@
 static atomic<int32_t> rendererCnt{-1};
 static SwMpool* globalMpool = nullptr;
 static uint32_t threadsCnt = 0;
+static atomic<int32_t> updatingCnt{0};           //renderers updating with the shared memory pool
 
 struct SwTask : Task
 {
@@ -47,6 +48,7 @@ struct SwTask : Task
     uint8_t opacity;
     bool pushed = false;                  //Pushed into task list?
     bool disposed = false;                //Disposed task?
+    bool purged = false;                  //Released the render data, regenerate all on the next visible update
 
     const RenderRegion& bounds()
     {
@@ -56,33 +58,78 @@ struct SwTask : Task
 
     virtual void dispose() = 0;
     virtual bool clip(SwRle* target) = 0;
+    virtual void memory(RenderMemory& out) = 0;
+    virtual void purge() = 0;
     virtual ~SwTask() {}
 };
 
 
+static bool _unclipped(const SwOutline& outline, const RenderRegion& clipBox)
+{
+    if (outline.pts.empty()) return true;
+
+    RenderRegion box;
+    mathUpdateOutlineBBox(&outline, {{INT32_MIN >> 1, INT32_MIN >> 1}, {INT32_MAX >> 1, INT32_MAX >> 1}}, box, false);
+    return RenderRegion::intersect(box, clipBox) == box;
+}
+
+
+static void _reset(SwOutline& outline)
+{
+    outline.pts.reset();
+    outline.cntrs.reset();
+    outline.types.reset();
+    outline.closed.reset();
+}
+
+
+static RenderRegion _translate(const RenderRegion& region, const SwPoint& offset)
+{
+    return {{region.min.x + offset.x, region.min.y + offset.y}, {region.max.x + offset.x, region.max.y + offset.y}};
+}
+
+
 struct SwShapeTask : SwTask
 {
     SwShape shape;
     const RenderShape* rshape = nullptr;
+    Array<SwInstance> instances;          //per-instance geometry of an instanced shape
+    SwOutline outline, strokeOutline;     //retained outlines of the base instance
+    SwRle *rle = nullptr, *strokeRle = nullptr;   //scratch spans for the shared instances
+    RenderRegion clipBox;
     bool clipper = false;
 
+    //the base instance which the retained instances are built on
+    struct {
+        Matrix transform;
+        RenderRegion clipBox;
+        RenderRegion renderBox;
+        RenderTrimPath trim;
+        uint32_t version;       //of the path
+        FillRule rule;
+        uint8_t opacity;
+        uint8_t quality;
+        bool shareable;
+    } built;
+
     /* We assume that if the stroke width is greater than 2,
        the shape's outline beneath the stroke could be adequately covered by the stroke drawing.
        Therefore, antialiasing is disabled under this condition.
        Additionally, the stroke style should not be dashed. */
     bool antialiasing(float strokeWidth)
     {
+        if (surface->quality >= NoAntialias) return false;
         return strokeWidth < 2.0f || rshape->stroke->dash.count > 0 || rshape->stroke->first || rshape->trimpath() || rshape->stroke->color.a < 255;
     }
 
-    float validStrokeWidth(bool clipper)
+    float validStrokeWidth(const Matrix& transform, uint8_t opacity, bool force)
     {
         if (!rshape->stroke) return 0.0f;
 
         auto width = rshape->stroke->width;
         if (tvg::zero(width)) return 0.0f;
 
-        if (!clipper && (!rshape->stroke->fill && (MULTIPLY(rshape->stroke->color.a, opacity) == 0))) return 0.0f;
+        if (!force && (!rshape->stroke->fill && (MULTIPLY(rshape->stroke->color.a, opacity) == 0))) return 0.0f;
         if (tvg::zero(rshape->stroke->trim.begin - rshape->stroke->trim.end)) return 0.0f;
 
         return (width * sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12));
@@ -96,53 +143,57 @@ struct SwShapeTask : SwTask
         return false;
     }
 
-    void run(unsigned tid) override
+    //force: generate the geometry regardless of its visibility (clipper or instanced base)
+    bool update(SwShape& shape, const Matrix& transform, uint8_t opacity, RenderRegion& renderBox, RenderUpdateFlag flags, unsigned tid, bool force, bool retain)
     {
-        //Invisible
-        if (opacity == 0 && !clipper) {
-            bbox.reset();
-            return;
-        }
-
-        auto strokeWidth = validStrokeWidth(clipper);
-        RenderRegion renderBox{};
+        auto strokeWidth = validStrokeWidth(transform, opacity, force);
         auto updateShape = flags & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform | RenderUpdateFlag::Clip);
         auto updateFill = false;
 
-        //Shape
-        if (updateShape || flags & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient)) {
+        //Shape, the stroke changes the antialiasing of the shape as well
+        if (updateShape || flags & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient | RenderUpdateFlag::Stroke)) {
             updateFill = (MULTIPLY(rshape->color.a, opacity) || rshape->fill);
-            if (updateShape) shapeReset(&shape);
-            if (updateFill || clipper) {
-                if (shapePrepare(&shape, rshape, transform, bbox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
-                    if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) goto err;
+            shapeReset(&shape);
+            if (updateFill || force) {
+                auto visible = shapePrepare(&shape, rshape, transform, clipBox, renderBox, mpool, tid, clips.count > 0 ? true : false);
+                if (retain) shapeCacheOutline(&shape, &outline);
+                if (visible) {
+                    if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) return false;
                 } else {
                     updateFill = false;
                     renderBox.reset();
+                    //the skipped color table is outdated, the unchanged gradient won't be flagged again
+                    if (flags & RenderUpdateFlag::Gradient) shapeDelFill(&shape);
                 }
             }
         }
         //Fill
         if (updateFill) {
             if (auto fill = rshape->fill) {
-                auto ctable = (flags & RenderUpdateFlag::Gradient) ? true : false;
+                auto ctable = (flags & RenderUpdateFlag::Gradient) || !shape.fill;
                 if (ctable) shapeResetFill(&shape);
-                if (!shapeGenFillColors(&shape, fill, transform, surface, opacity, ctable)) goto err;
+                if (!shapeGenFillColors(&shape, fill, transform, surface, opacity, ctable)) return false;
             }
         }
         //Stroke
-        if (updateShape || flags & RenderUpdateFlag::Stroke) {
+        if (updateShape || flags & (RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke)) {
             if (strokeWidth > 0.0f) {
                 shapeResetStroke(&shape, rshape, transform);
-                if (!shapeGenStrokeRle(&shape, rshape, transform, bbox, renderBox, mpool, tid)) goto err;
+                //the retained outline is still valid for the other instances
+                if (!shapeGenStrokeRle(&shape, rshape, transform, clipBox, renderBox, mpool, tid, retain ? &strokeOutline : nullptr) && !retain) return false;
+                shape.strokeBox = renderBox;
                 if (auto fill = rshape->strokeFill()) {
-                    auto ctable = (flags & RenderUpdateFlag::GradientStroke) ? true : false;
+                    //the deleted stroke loses its color table as well
+                    auto ctable = (flags & RenderUpdateFlag::GradientStroke) || !shape.stroke->fill;
                     if (ctable) shapeResetStrokeFill(&shape);
-                    if (!shapeGenStrokeFillColors(&shape, fill, transform, surface, opacity, ctable)) goto err;
+                    if (!shapeGenStrokeFillColors(&shape, fill, transform, surface, opacity, ctable)) return false;
                 }
             } else {
                 shapeDelStroke(&shape);
             }
+        //the retained stroke region embraces the shape region
+        } else if (shape.strokeRle) {
+            renderBox = shape.strokeBox;
         }
 
         //Clear current task memorypool here if the clippers would use the same memory pool
@@ -153,23 +204,206 @@ struct SwShapeTask : SwTask
             auto clipper = static_cast<SwTask*>(*p);
             auto clipShapeRle = shape.rle ? clipper->clip(shape.rle) : true;
             auto clipStrokeRle = shape.strokeRle ? clipper->clip(shape.strokeRle) : true;
-            if (!clipShapeRle && !clipStrokeRle) goto err;
+            if (!clipShapeRle && !clipStrokeRle) return false;
         }
 
-        bbox = renderBox; //sync
+        return true;
+    }
 
-        return;
+    void clear()
+    {
+        ARRAY_FOREACH(p, instances) shapeFreeInstance(p);
+        instances.clear();
+        outline.pts.clear();
+        strokeOutline.pts.clear();
+    }
+
+    //the base instance geometry is built again, or the colors and the other instances are changed only
+    bool reshape(const Matrix& m, uint8_t baseOpacity)
+    {
+        if (instances.empty() || !clips.empty()) return true;
+        if (flags & (RenderUpdateFlag::Stroke | RenderUpdateFlag::Clip | RenderUpdateFlag::Gradient | RenderUpdateFlag::GradientStroke)) return true;
+        if (built.quality != surface->quality || built.opacity != baseOpacity || !(built.clipBox == clipBox) || built.transform != m) return true;
+        if (flags & RenderUpdateFlag::Path) {
+            //the instances mark the path as well, the borrowed buffers might have been modified by the caller
+            if (built.version != rshape->path.version || rshape->path.data->borrowed || built.rule != rshape->rule) return true;
+            RenderTrimPath trim;
+            if (rshape->stroke) trim = rshape->stroke->trim;
+            if (built.trim.begin != trim.begin || built.trim.end != trim.end || built.trim.simultaneous != trim.simultaneous) return true;
+        }
+        return false;
+    }
+
+    /* The first instance is the base. Instances that only differ by a translation reuse its outlines,
+       and the integer pixel translations even reuse its spans, so geometry is built only for the
+       instances with a different linear transform. The built instances are kept over the updates,
+       only the ones whose transform is changed are built again unless the base is changed. */
+    void runInstances(unsigned tid)
+    {
+        auto& base = rshape->instances[0];
+        auto m = transform * base.m;
+        auto baseOpacity = MULTIPLY(opacity, base.opacity);
+        auto rebuild = reshape(m, baseOpacity);
+
+        if (rebuild) {
+            built.renderBox = {};
+            if (!update(shape, m, baseOpacity, built.renderBox, RenderUpdateFlag::All, tid, true, true)) {
+                clear();
+                bbox.reset();
+                shapeReset(&shape);
+                rleReset(shape.strokeRle);
+                shapeDelOutline(&shape, mpool, tid);
+                return;
+            }
+            //The base spans can be moved around as long as they are not cut off by the clip region
+            built.shareable = clips.empty() && !shape.fastTrack && _unclipped(outline, clipBox) && _unclipped(strokeOutline, clipBox);
+            built.transform = m;
+            built.clipBox = clipBox;
+            built.version = rshape->path.version;
+            built.rule = rshape->rule;
+            built.trim = rshape->stroke ? rshape->stroke->trim : RenderTrimPath();
+            built.opacity = baseOpacity;
+            built.quality = surface->quality;
+        }
+
+        auto gradient = rshape->fill || rshape->strokeFill();
+        auto& renderBox = built.renderBox;
+
+        //the removed instances
+        for (auto i = rshape->instances.count; i < instances.count; ++i) shapeFreeInstance(&instances[i]);
+        instances.count = std::min(instances.count, rshape->instances.count);
+        instances.grow(rshape->instances.count - instances.count);
 
-    err:
         bbox.reset();
-        shapeReset(&shape);
-        rleReset(shape.strokeRle);
-        shapeDelOutline(&shape, mpool, tid);
+
+        Point origin = {0.0f, 0.0f};
+        auto pivot = mathTransform(&origin, m);
+        auto aa = antialiasing(validStrokeWidth(m, baseOpacity, true));
+
+        for (uint32_t i = 0; i < rshape->instances.count; ++i) {
+            auto p = &rshape->instances[i];
+            auto added = i >= instances.count;
+            auto& inst = added ? instances.next() : instances[i];
+            if (added) inst = {};
+
+            auto tm = transform * p->m;
+            auto opacity = MULTIPLY(this->opacity, p->opacity);
+
+            //the same geometry on the same base, the gradient color table is baked with the opacity
+            auto reuse = !rebuild && !added && inst.opacity > 0 && opacity > 0 && inst.transform == tm && (!gradient || inst.opacity == opacity);
+            inst.transform = tm;
+            inst.opacity = opacity;
+
+            if (!reuse) {
+                inst.bbox.reset();
+                inst.renderBox.reset();
+                inst.shared = false;
+                if (opacity == 0) continue;
+
+                //base instance
+                if (i == 0) {
+                    inst.bbox = shape.bbox;
+                    inst.renderBox = renderBox;
+                    inst.shared = true;
+                } else {
+                    auto linear = tvg::equal(tm.e11, m.e11) && tvg::equal(tm.e12, m.e12) && tvg::equal(tm.e21, m.e21) && tvg::equal(tm.e22, m.e22);
+                    //the gradient color table is baked with the base opacity
+                    if (linear && (!gradient || opacity == baseOpacity)) {
+                        if (inst.shape) shapeFreeInstance(&inst);
+                        inst.offset = mathTransform(&origin, tm) - pivot;
+                        //integer pixel translation
+                        if (built.shareable && (inst.offset.x & 63) == 0 && (inst.offset.y & 63) == 0) {
+                            inst.offset = {inst.offset.x >> 6, inst.offset.y >> 6};
+                            inst.bbox = RenderRegion::intersect(_translate(shape.bbox, inst.offset), clipBox);
+                            inst.renderBox = RenderRegion::intersect(_translate(renderBox, inst.offset), clipBox);
+                            inst.shared = true;
+                        } else if (shapeGenInstance(&inst, &shape, &outline, &strokeOutline, clipBox, mpool, tid, aa)) {
+                            ARRAY_FOREACH(p, clips) {
+                                auto clipper = static_cast<SwTask*>(*p);
+                                if (inst.rle) clipper->clip(inst.rle);
+                                if (inst.strokeRle) clipper->clip(inst.strokeRle);
+                            }
+                        }
+                    //unique geometry, its former spans are reused
+                    } else {
+                        if (!inst.shape) inst.shape = new SwShape;
+                        if (!update(*inst.shape, tm, opacity, inst.renderBox, RenderUpdateFlag::All, tid, true, false)) {
+                            inst.renderBox.reset();
+                        }
+                        inst.bbox = inst.shape->bbox;
+                    }
+                }
+            }
+            if (inst.renderBox.invalid()) continue;
+            if (bbox.valid()) bbox.add(inst.renderBox);
+            else bbox = inst.renderBox;
+        }
+    }
+
+    void run(unsigned tid) override
+    {
+        //Invisible
+        if (opacity == 0 && !clipper) {
+            clear();
+            bbox.reset();
+            return;
+        }
+
+        clipBox = bbox;
+        purged = false;
+
+        if (rshape->instanced() && !clipper) {
+            runInstances(tid);
+            return;
+        }
+
+        clear();
+
+        RenderRegion renderBox{};
+
+        if (!update(shape, transform, opacity, renderBox, flags, tid, clipper, false)) {
+            bbox.reset();
+            shapeReset(&shape);
+            rleReset(shape.strokeRle);
+            shapeDelOutline(&shape, mpool, tid);
+            return;
+        }
+
+        bbox = renderBox; //sync
     }
 
     void dispose() override
     {
-       shapeFree(&shape);
+        clear();
+        rleFree(rle);
+        rle = nullptr;
+        rleFree(strokeRle);
+        strokeRle = nullptr;
+        shapeFree(&shape);
+    }
+
+    void memory(RenderMemory& out) override
+    {
+        shapeMemory(&shape, out);
+
+        ARRAY_FOREACH(p, instances) {
+            if (p->shape) shapeMemory(p->shape, out);
+            if (p->rle) out[MemoryType::Geometry] += p->rle->memory();
+            if (p->strokeRle) out[MemoryType::Geometry] += p->strokeRle->memory();
+        }
+        out[MemoryType::Geometry] += instances.reserved * sizeof(SwInstance) + outline.memory() + strokeOutline.memory();
+        if (rle) out[MemoryType::Geometry] += rle->memory();
+        if (strokeRle) out[MemoryType::Geometry] += strokeRle->memory();
+    }
+
+    void purge() override
+    {
+        dispose();
+        instances.reset();
+        _reset(outline);
+        _reset(strokeOutline);
+        bbox.reset();
+        purged = true;
     }
 };
 
@@ -201,6 +435,7 @@ struct SwImageTask : SwTask
 
         //Invisible shape turned to visible by alpha.
         if ((flags & (RenderUpdateFlag::Image | RenderUpdateFlag::Transform | RenderUpdateFlag::Color)) && (opacity > 0)) {
+            purged = false;
             imageReset(&image);
             if (!image.data || image.w == 0 || image.h == 0) goto end;
 
@@ -230,31 +465,108 @@ struct SwImageTask : SwTask
     {
        imageFree(&image);
     }
+
+    void memory(RenderMemory& out) override
+    {
+        if (image.rle) out[MemoryType::Geometry] += image.rle->memory();
+    }
+
+    void purge() override
+    {
+        imageFree(&image);
+        image.rle = nullptr;
+        bbox.reset();
+        purged = true;
+    }
 };
 
 
-static void _renderFill(SwShapeTask* task, SwSurface* surface)
+static void _renderFill(SwShapeTask* task, SwShape* shape, RenderColor c, uint8_t opacity, SwSurface* surface)
 {
     if (auto fill = task->rshape->fill) {
-        rasterGradientShape(surface, &task->shape, fill, task->opacity);
+        rasterGradientShape(surface, shape, fill, opacity);
     } else {
-        RenderColor c;
-        task->rshape->fillColor(&c.r, &c.g, &c.b, &c.a);
-        c.a = MULTIPLY(task->opacity, c.a);
-        if (c.a > 0) rasterShape(surface, &task->shape, c);
+        c.a = MULTIPLY(opacity, c.a);
+        if (c.a > 0) rasterShape(surface, shape, c);
     }
 }
 
-static void _renderStroke(SwShapeTask* task, SwSurface* surface)
+
+static void _renderStroke(SwShapeTask* task, SwShape* shape, uint8_t opacity, SwSurface* surface)
 {
     if (auto strokeFill = task->rshape->strokeFill()) {
-        rasterGradientStroke(surface, &task->shape, strokeFill, task->opacity);
+        rasterGradientStroke(surface, shape, strokeFill, opacity);
     } else {
         RenderColor c;
         if (task->rshape->strokeFill(&c.r, &c.g, &c.b, &c.a)) {
-            c.a = MULTIPLY(task->opacity, c.a);
-            if (c.a > 0) rasterStroke(surface, &task->shape, c);
+            c.a = MULTIPLY(opacity, c.a);
+            if (c.a > 0) rasterStroke(surface, shape, c);
+        }
+    }
+}
+
+
+static void _renderShape(SwShapeTask* task, SwShape* shape, const RenderColor& c, uint8_t opacity, SwSurface* surface)
+{
+    if (task->rshape->strokeFirst()) {
+        _renderStroke(task, shape, opacity, surface);
+        _renderFill(task, shape, c, opacity, surface);
+    } else {
+        _renderFill(task, shape, c, opacity, surface);
+        _renderStroke(task, shape, opacity, surface);
+    }
+}
+
+
+static void _renderInstances(SwShapeTask* task, SwSurface* surface)
+{
+    auto& base = task->shape;
+
+    for (uint32_t i = 0; i < task->instances.count; ++i) {
+        auto& inst = task->instances[i];
+        if (inst.renderBox.invalid()) continue;
+
+        auto c = task->rshape->instanceColor(i);
+
+        //unique geometry
+        if (inst.shape) {
+            _renderShape(task, inst.shape, c, inst.opacity, surface);
+            continue;
+        }
+        //base instance
+        if (i == 0) {
+            _renderShape(task, &base, c, inst.opacity, surface);
+            continue;
+        }
+
+        //a translated view of the base instance
+        SwShape view = base;
+        SwFill fill, strokeFill;
+        SwStroke stroke;
+
+        view.bbox = inst.bbox;
+        if (inst.shared) {
+            if (base.rle) view.rle = task->rle = rleTranslate(task->rle, base.rle, inst.offset.x, inst.offset.y, task->clipBox);
+            if (base.strokeRle) view.strokeRle = task->strokeRle = rleTranslate(task->strokeRle, base.strokeRle, inst.offset.x, inst.offset.y, task->clipBox);
+        } else {
+            view.rle = inst.rle;
+            view.strokeRle = inst.strokeRle;
+        }
+        if (base.fill) {
+            fill = *base.fill;
+            fillGenColorTable(&fill, task->rshape->fill, inst.transform, surface, inst.opacity, false);
+            view.fill = &fill;
         }
+        if (base.stroke) {
+            stroke = *base.stroke;
+            if (base.stroke->fill) {
+                strokeFill = *base.stroke->fill;
+                fillGenColorTable(&strokeFill, task->rshape->strokeFill(), inst.transform, surface, inst.opacity, false);
+                stroke.fill = &strokeFill;
+            }
+            view.stroke = &stroke;
+        }
+        _renderShape(task, &view, c, inst.opacity, surface);
     }
 }
 
@@ -306,6 +618,7 @@ bool SwRenderer::sync()
             (*p)->pushed = false;
         }
     }
+    if (sharedMpool && !tasks.empty()) --updatingCnt;
     tasks.clear();
 
     return true;
@@ -334,7 +647,12 @@ bool SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h,
 
 bool SwRenderer::preUpdate()
 {
-    return surface != nullptr;
+    if (!surface) return false;
+
+    //the tasks take the quality of the update, it's changed only while they are synced
+    if (surface->quality != level) surface->quality = level;
+
+    return true;
 }
 
 
@@ -419,12 +737,11 @@ bool SwRenderer::renderShape(RenderData data)
     if (task->opacity == 0) return true;
 
     //Main raster stage
-    if (task->rshape->strokeFirst()) {
-        _renderStroke(task, surface);
-        _renderFill(task, surface);
-    } else {
-        _renderFill(task, surface);
-        _renderStroke(task, surface);
+    if (!task->instances.empty()) _renderInstances(task, surface);
+    else {
+        RenderColor c;
+        task->rshape->fillColor(&c.r, &c.g, &c.b, &c.a);
+        _renderShape(task, &task->shape, c, task->opacity, surface);
     }
 
     return true;
@@ -612,8 +929,8 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 void SwRenderer::prepare(RenderEffect* effect, const Matrix& transform)
 {
     switch (effect->type) {
-        case SceneEffect::GaussianBlur: effectGaussianBlurUpdate(static_cast<RenderEffectGaussianBlur*>(effect), transform); break;
-        case SceneEffect::DropShadow: effectDropShadowUpdate(static_cast<RenderEffectDropShadow*>(effect), transform); break;
+        case SceneEffect::GaussianBlur: effectGaussianBlurUpdate(static_cast<RenderEffectGaussianBlur*>(effect), transform, surface->quality >= CoarseBlur); break;
+        case SceneEffect::DropShadow: effectDropShadowUpdate(static_cast<RenderEffectDropShadow*>(effect), transform, surface->quality >= CoarseBlur); break;
         case SceneEffect::Fill: effectFillUpdate(static_cast<RenderEffectFill*>(effect)); break;
         case SceneEffect::Tint: effectTintUpdate(static_cast<RenderEffectTint*>(effect)); break;
         case SceneEffect::Tritone: effectTritoneUpdate(static_cast<RenderEffectTritone*>(effect)); break;
@@ -703,9 +1020,13 @@ void* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const Arr
     task->transform = transform;
     task->clips = clips;
     task->opacity = opacity;
+
+    //the purged render data has nothing left to be partially updated
+    if (task->purged) flags = RenderUpdateFlag::All;
     task->flags = flags;
 
     if (!task->pushed) {
+        if (sharedMpool && tasks.empty()) ++updatingCnt;
         task->pushed = true;
         tasks.push(task);
     }
@@ -753,6 +1074,60 @@ RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const
 }
 
 
+void SwRenderer::memory(RenderData data, RenderMemory& out)
+{
+    auto task = static_cast<SwTask*>(data);
+    task->done();
+    task->memory(out);
+}
+
+
+void SwRenderer::memory(RenderMemory& out)
+{
+    ARRAY_FOREACH(p, compositors) {
+        auto& image = (*p)->compositor->image;
+        out[MemoryType::Compositor] += image.channelSize * image.stride * image.h;
+    }
+    //the shared memory pool is reported by the engine
+    if (!sharedMpool) out[MemoryType::Geometry] += mpoolMemory(mpool);
+}
+
+
+void SwRenderer::purge(RenderData data)
+{
+    auto task = static_cast<SwTask*>(data);
+    task->done();
+    task->purge();
+}
+
+
+void SwRenderer::purge()
+{
+    clearCompositors();
+
+    //the shared memory pool might be in use by the other renderers
+    if (!sharedMpool || updatingCnt == 0) mpoolClear(mpool);
+}
+
+
+void SwRenderer::wait()
+{
+    ARRAY_FOREACH(p, tasks) (*p)->done();
+}
+
+
+bool SwRenderer::instancing()
+{
+    return true;
+}
+
+
+void SwRenderer::poolMemory(RenderMemory& out)
+{
+    if (globalMpool) out[MemoryType::Geometry] += mpoolMemory(globalMpool);
+}
+
+
 bool SwRenderer::term()
 {
     if (rendererCnt > 0) return false;
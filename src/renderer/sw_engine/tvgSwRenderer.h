@@ -66,8 +66,16 @@ public:
     bool render(RenderCompositor* cmp, const RenderEffect* effect, bool direct) override;
     void dispose(RenderEffect* effect) override;
 
+    void memory(RenderData data, RenderMemory& out) override;
+    void memory(RenderMemory& out) override;
+    void purge(RenderData data) override;
+    void purge() override;
+    void wait() override;
+    bool instancing() override;
+
     static SwRenderer* gen(uint32_t threads);
     static bool term();
+    static void poolMemory(RenderMemory& out);
 
 private:
     SwSurface*           surface = nullptr;           //active surface
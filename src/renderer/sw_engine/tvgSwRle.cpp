@@ -862,6 +862,31 @@ SwRle* rleRender(const RenderRegion* bbox)
 }
 
 
+SwRle* rleTranslate(SwRle* rle, const SwRle* src, int32_t x, int32_t y, const RenderRegion& clip)
+{
+    if (!rle) rle = new SwRle;
+    rle->spans.clear();
+    if (!src) return rle;
+
+    rle->spans.reserve(src->spans.count);
+    auto data = rle->spans.data;
+
+    //spans are sorted by y-coordinates
+    ARRAY_FOREACH(p, src->spans) {
+        auto sy = p->y + y;
+        if (sy < clip.min.y) continue;
+        if (sy >= clip.max.y) break;
+        auto x1 = std::max(p->x + x, clip.min.x);
+        auto x2 = std::min(p->x + p->len + x, clip.max.x);
+        if (x2 <= x1) continue;
+        *data = {uint16_t(x1), uint16_t(sy), uint16_t(x2 - x1), p->coverage};
+        ++data;
+        ++rle->spans.count;
+    }
+    return rle;
+}
+
+
 void rleReset(SwRle* rle)
 {
     if (rle) rle->spans.clear();
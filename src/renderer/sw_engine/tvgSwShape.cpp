@@ -236,26 +236,13 @@ static void _dashMoveTo(SwDashStroke& dash, uint32_t offIdx, float offset, const
 
 static SwOutline* _genDashOutline(const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid, bool trimmed)
 {
-    PathCommand *cmds, *trimmedCmds = nullptr;
-    Point *pts, *trimmedPts = nullptr;
-    uint32_t cmdCnt, ptsCnt;
-
-    if (trimmed) {
-        RenderPath trimmedPath;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmedPath)) return nullptr;
-        cmds = trimmedCmds = trimmedPath.cmds.data;
-        cmdCnt = trimmedPath.cmds.count;
-        pts = trimmedPts = trimmedPath.pts.data;
-        ptsCnt = trimmedPath.pts.count;
-
-        trimmedPath.cmds.data = nullptr;
-        trimmedPath.pts.data = nullptr;
-    } else {
-        cmds = rshape->path.cmds.data;
-        cmdCnt = rshape->path.cmds.count;
-        pts = rshape->path.pts.data;
-        ptsCnt = rshape->path.pts.count;
-    }
+    auto path = trimmed ? rshape->trimmedPath() : &*rshape->path;
+    if (!path) return nullptr;
+
+    auto cmds = path->cmds.data;
+    auto cmdCnt = path->cmds.count;
+    auto pts = path->pts.data;
+    auto ptsCnt = path->pts.count;
 
     //No actual shape data
     if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
@@ -316,15 +303,28 @@ static SwOutline* _genDashOutline(const RenderShape* rshape, const Matrix& trans
         ++cmds;
     }
 
-    tvg::free(trimmedCmds);
-    tvg::free(trimmedPts);
-
     _outlineEnd(*dash.outline);
 
     return dash.outline;
 }
 
 
+static void _translateOutline(SwOutline& dst, const SwOutline& src, const SwPoint& offset)
+{
+    dst.pts = src.pts;
+    dst.cntrs = src.cntrs;
+    dst.types = src.types;
+    dst.closed = src.closed;
+    dst.fillRule = src.fillRule;
+
+    if (offset.zero()) return;
+
+    ARRAY_FOREACH(p, dst.pts) {
+        *p += offset;
+    }
+}
+
+
 static bool _axisAlignedRect(const SwOutline* outline)
 {
     //Fast Track: axis-aligned rectangle?
@@ -347,27 +347,14 @@ static bool _axisAlignedRect(const SwOutline* outline)
 
 static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid, bool hasComposite, bool trimmed = false)
 {
-    PathCommand *cmds, *trimmedCmds = nullptr;
-    Point *pts, *trimmedPts = nullptr;
-    uint32_t cmdCnt, ptsCnt;
+    //the path data might be borrowed from the user, read it in place without copying
+    auto path = trimmed ? rshape->trimmedPath() : &*rshape->path;
+    if (!path) return nullptr;
 
-    if (trimmed) {
-        RenderPath trimmedPath;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmedPath)) return nullptr;
-
-        cmds = trimmedCmds = trimmedPath.cmds.data;
-        cmdCnt = trimmedPath.cmds.count;
-        pts = trimmedPts = trimmedPath.pts.data;
-        ptsCnt = trimmedPath.pts.count;
-
-        trimmedPath.cmds.data = nullptr;
-        trimmedPath.pts.data = nullptr;
-    } else {
-        cmds = rshape->path.cmds.data;
-        cmdCnt = rshape->path.cmds.count;
-        pts = rshape->path.pts.data;
-        ptsCnt = rshape->path.pts.count;
-    }
+    auto cmds = path->cmds.data;
+    auto cmdCnt = path->cmds.count;
+    auto pts = path->pts.data;
+    auto ptsCnt = path->pts.count;
 
     //No actual shape data
     if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
@@ -407,9 +394,6 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
 
     outline->fillRule = rshape->rule;
 
-    tvg::free(trimmedCmds);
-    tvg::free(trimmedPts);
-
     shape->fastTrack = (!hasComposite && _axisAlignedRect(outline));
     return outline;
 }
@@ -500,7 +484,7 @@ void shapeResetStroke(SwShape* shape, const RenderShape* rshape, const Matrix& t
 }
 
 
-bool shapeGenStrokeRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid)
+bool shapeGenStrokeRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, SwOutline* cache)
 {
     SwOutline* shapeOutline = nullptr;
     SwOutline* strokeOutline = nullptr;
@@ -527,6 +511,7 @@ bool shapeGenStrokeRle(SwShape* shape, const RenderShape* rshape, const Matrix&
     }
 
     strokeOutline = strokeExportOutline(shape->stroke, mpool, tid);
+    if (cache) _translateOutline(*cache, *strokeOutline, {0, 0});
 
     if (!mathUpdateOutlineBBox(strokeOutline, clipBox, renderBox, false)) {
         ret = false;
@@ -589,3 +574,72 @@ void shapeDelStrokeFill(SwShape* shape)
     fillFree(shape->stroke->fill);
     shape->stroke->fill = nullptr;
 }
+
+
+void shapeMemory(const SwShape* shape, RenderMemory& out)
+{
+    if (shape->rle) out[MemoryType::Geometry] += shape->rle->memory();
+    if (shape->strokeRle) out[MemoryType::Geometry] += shape->strokeRle->memory();
+    out[MemoryType::Gradient] += fillMemory(shape->fill);
+
+    if (auto stroke = shape->stroke) {
+        out[MemoryType::Geometry] += sizeof(SwStroke);
+        for (int i = 0; i < 2; ++i) {
+            out[MemoryType::Geometry] += stroke->borders[i].maxPts * (sizeof(SwPoint) + sizeof(uint8_t));
+        }
+        out[MemoryType::Gradient] += fillMemory(stroke->fill);
+    }
+}
+
+
+void shapeCacheOutline(const SwShape* shape, SwOutline* cache)
+{
+    if (shape->outline) _translateOutline(*cache, *shape->outline, {0, 0});
+}
+
+
+bool shapeGenInstance(SwInstance* inst, const SwShape* base, const SwOutline* outline, const SwOutline* strokeOutline, const RenderRegion& clipBox, SwMpool* mpool, unsigned tid, bool antiAlias)
+{
+    inst->bbox.reset();
+    inst->renderBox.reset();
+    rleReset(inst->rle);
+    rleReset(inst->strokeRle);
+
+    //Fill: the translated base outline
+    if (!outline->pts.empty()) {
+        auto out = mpoolReqOutline(mpool, tid);
+        _translateOutline(*out, *outline, inst->offset);
+        if (mathUpdateOutlineBBox(out, clipBox, inst->bbox, base->fastTrack) && !base->fastTrack) {
+            inst->rle = rleRender(inst->rle, out, inst->bbox, antiAlias);
+        }
+        inst->renderBox = inst->bbox;
+        mpoolRetOutline(mpool, tid);
+    }
+
+    //Stroke: the translated base stroke outline
+    if (!strokeOutline->pts.empty()) {
+        auto out = mpoolReqStrokeOutline(mpool, tid);
+        _translateOutline(*out, *strokeOutline, inst->offset);
+        if (mathUpdateOutlineBBox(out, clipBox, inst->renderBox, false)) {
+            inst->strokeRle = rleRender(inst->strokeRle, out, inst->renderBox, true);
+        }
+        mpoolRetStrokeOutline(mpool, tid);
+    }
+
+    return inst->renderBox.valid();
+}
+
+
+void shapeFreeInstance(SwInstance* inst)
+{
+    rleFree(inst->rle);
+    inst->rle = nullptr;
+    rleFree(inst->strokeRle);
+    inst->strokeRle = nullptr;
+
+    if (inst->shape) {
+        shapeFree(inst->shape);
+        delete(inst->shape);
+        inst->shape = nullptr;
+    }
+}
@@ -42,8 +42,11 @@ Result Animation::frame(float no) noexcept
     if (!loader) return Result::InsufficientCondition;
     if (!loader->animatable()) return Result::NonSupport;
 
+    PICTURE(pImpl->picture)->wait();
+
+    //the changed paints of the frame are marked by themselves, only the picture needs to be visited
     if (static_cast<FrameModule*>(loader)->frame(no)) {
-        PAINT(pImpl->picture)->mark(RenderUpdateFlag::All);
+        PICTURE(pImpl->picture)->changed = true;
         return Result::Success;
     }
     return Result::InsufficientCondition;
@@ -20,8 +20,54 @@
  * SOFTWARE.
  */
 
+#include <chrono>
 #include "tvgCanvas.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static double _now()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void Canvas::Impl::measure()
+{
+    if (limit > 0.0f && !measuring) {
+        begin = _now();
+        measuring = true;
+    }
+}
+
+
+/* Lower the quality one level per frame overrunning the budget, then restore it one level
+   after the successive frames finished within the half budget. */
+void Canvas::Impl::adapt()
+{
+    static constexpr uint8_t HEADROOM_FRAMES = 10;
+
+    if (!measuring) return;
+    measuring = false;
+
+    auto elapsed = float(_now() - begin);
+
+    if (elapsed > limit) {
+        headroom = 0;
+        if (level < NoAntialias) quality(level + 1);
+    } else if (elapsed < limit * 0.5f && level > FullQuality) {
+        if (++headroom >= HEADROOM_FRAMES) quality(level - 1);
+    } else {
+        headroom = 0;
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
 Canvas::Canvas():pImpl(new Impl)
 {
 }
@@ -72,6 +118,12 @@ Result Canvas::remove(Paint* paint) noexcept
 }
 
 
+Result Canvas::swap(Paint* target, Paint* paint) noexcept
+{
+    return pImpl->swap(target, paint);
+}
+
+
 Result Canvas::viewport(int32_t x, int32_t y, int32_t w, int32_t h) noexcept
 {
     return pImpl->viewport(x, y, w, h);
@@ -81,4 +133,28 @@ Result Canvas::viewport(int32_t x, int32_t y, int32_t w, int32_t h) noexcept
 Result Canvas::sync() noexcept
 {
     return pImpl->sync();
+}
+
+
+size_t Canvas::memory(MemoryType type) const noexcept
+{
+    return pImpl->memory(type);
+}
+
+
+Result Canvas::purge() noexcept
+{
+    return pImpl->purge();
+}
+
+
+Result Canvas::budget(float ms) noexcept
+{
+    return pImpl->budget(ms);
+}
+
+
+uint8_t Canvas::quality() const noexcept
+{
+    return NoAntialias - pImpl->level;
 }
\ No newline at end of file
@@ -34,6 +34,13 @@ struct Canvas::Impl
     RenderRegion vport = {{0, 0}, {INT32_MAX, INT32_MAX}};
     Status status = Status::Synced;
 
+    //frame budget
+    double begin = 0.0;        //the first update or draw of the measured frame in milliseconds
+    float limit = 0.0f;        //the budget in milliseconds, zero disables it
+    uint8_t level = FullQuality;
+    uint8_t headroom = 0;      //the successive frames finished within the half budget
+    bool measuring = false;
+
     Impl() : scene(Scene::gen())
     {
         scene->ref();
@@ -65,6 +72,21 @@ struct Canvas::Impl
         return scene->remove(paint);
     }
 
+    Result swap(Paint* target, Paint* paint)
+    {
+        //You cannot swap paints during rendering.
+        if (status == Status::Drawing) return Result::InsufficientCondition;
+        if (!target || !paint) return Result::InvalidArguments;
+        if (PAINT(target)->parent != scene || PAINT(paint)->parent) return Result::InsufficientCondition;
+
+        //take over the position, then release the previous one.
+        auto ret = scene->push(paint, target);
+        if (ret != Result::Success) return ret;
+        scene->remove(target);
+
+        return update(paint, true);
+    }
+
     Result update(Paint* paint, bool force)
     {
         Array<RenderData> clips;
@@ -73,6 +95,8 @@ struct Canvas::Impl
 
         if (!renderer->preUpdate()) return Result::InsufficientCondition;
 
+        measure();
+
         auto m = tvg::identity();
         if (paint) PAINT(paint)->update(renderer, m, clips, 255, flag);
         else PAINT(scene)->update(renderer, m, clips, 255, flag);
@@ -91,6 +115,8 @@ struct Canvas::Impl
         if (status == Status::Damaged) update(nullptr, false);
         if (!renderer->preRender()) return Result::InsufficientCondition;
 
+        measure();
+
         if (!PAINT(scene)->render(renderer) || !renderer->postRender()) return Result::InsufficientCondition;
 
         status = Status::Drawing;
@@ -104,12 +130,55 @@ struct Canvas::Impl
 
         if (renderer->sync()) {
             status = Status::Synced;
+            adapt();
             return Result::Success;
         }
 
         return Result::Unknown;
     }
 
+    size_t memory(MemoryType type)
+    {
+        RenderMemory out;
+        PAINT(scene)->memory(out);
+        renderer->memory(out);
+        return out.get(type);
+    }
+
+    Result purge()
+    {
+        //The render data might be in use until the canvas is synced.
+        if (status != Status::Synced && status != Status::Damaged) return Result::InsufficientCondition;
+
+        PAINT(scene)->purge(false);
+        renderer->purge();
+
+        return Result::Success;
+    }
+
+    void measure();
+    void adapt();
+
+    //the paints updated from the next frame take the level, the lowered ones are prepared again when it's raised
+    void quality(uint8_t level)
+    {
+        if (this->level == level) return;
+        if (level < this->level) PAINT(scene)->refine(level);
+        this->level = level;
+        headroom = 0;
+        renderer->quality(level);
+    }
+
+    Result budget(float ms)
+    {
+        if (ms < 0.0f) return Result::InvalidArguments;
+        if (status != Status::Damaged && status != Status::Synced) return Result::InsufficientCondition;
+        limit = ms;
+        measuring = false;
+        if (tvg::zero(ms)) quality(FullQuality);
+        return Result::Success;
+    }
+
     Result viewport(int32_t x, int32_t y, int32_t w, int32_t h)
     {
         if (status != Status::Damaged && status != Status::Synced) return Result::InsufficientCondition;
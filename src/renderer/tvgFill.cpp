@@ -22,6 +22,17 @@
 
 #include "tvgFill.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+uint64_t tvg::hash(const Fill* fill)
+{
+    if (!fill) return 0;
+    if (fill->type() == Type::LinearGradient) return CONST_LINEAR(fill)->hash();
+    return CONST_RADIAL(fill)->hash();
+}
+
 
 /************************************************************************/
 /* Fill Class Implementation                                            */
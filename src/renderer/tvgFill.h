@@ -25,6 +25,7 @@
 
 #include "tvgCommon.h"
 #include "tvgMath.h"
+#include "tvgCompressor.h"
 
 #define LINEAR(A) static_cast<LinearGradientImpl*>(A)
 #define CONST_LINEAR(A) static_cast<const LinearGradientImpl*>(A)
@@ -53,6 +54,13 @@ struct Fill::Impl
         transform = dup.transform;
     }
 
+    uint64_t hash(uint64_t seed) const
+    {
+        seed = fnv1aEncode(&spread, sizeof(spread), seed);
+        seed = fnv1aEncode(&transform, sizeof(transform), seed);
+        return fnv1aEncode(colorStops, sizeof(ColorStop) * cnt, seed);
+    }
+
     Result update(const ColorStop* colorStops, uint32_t cnt)
     {
         if ((!colorStops && cnt > 0) || (colorStops && cnt == 0)) return Result::InvalidArguments;
@@ -105,6 +113,13 @@ struct RadialGradientImpl : RadialGradient
         return ret;
     }
 
+    uint64_t hash() const
+    {
+        auto type = tvg::Type::RadialGradient;
+        float params[] = {cx, cy, r, fx, fy, fr};
+        return impl.hash(fnv1aEncode(params, sizeof(params), fnv1aEncode(&type, sizeof(type))));
+    }
+
     Result radial(float cx, float cy, float r, float fx, float fy, float fr)
     {
         if (r < 0 || fr < 0) return Result::InvalidArguments;
@@ -159,6 +174,13 @@ struct LinearGradientImpl :  LinearGradient
         return ret;
     }
 
+    uint64_t hash() const
+    {
+        auto type = tvg::Type::LinearGradient;
+        float params[] = {x1, y1, x2, y2};
+        return impl.hash(fnv1aEncode(params, sizeof(params), fnv1aEncode(&type, sizeof(type))));
+    }
+
     Result linear(float x1, float y1, float x2, float y2) noexcept
     {
         this->x1 = x1;
@@ -181,4 +203,10 @@ struct LinearGradientImpl :  LinearGradient
 };
 
 
+namespace tvg
+{
+    //digest of the gradient properties to detect the changes, zero for nullptr
+    uint64_t hash(const Fill* fill);
+}
+
 #endif  //_TVG_FILL_H_
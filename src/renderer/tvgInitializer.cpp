@@ -127,6 +127,19 @@ const char* Initializer::version(uint32_t* major, uint32_t* minor, uint32_t* mic
 }
 
 
+size_t Initializer::memory(MemoryType type) noexcept
+{
+    RenderMemory out;
+
+#ifdef THORVG_SW_RASTER_SUPPORT
+    SwRenderer::poolMemory(out);
+#endif
+    LoaderMgr::memory(out);
+
+    return out.get(type);
+}
+
+
 uint16_t THORVG_VERSION_NUMBER()
 {
     return _version;
@@ -64,6 +64,7 @@ struct LoadModule
     virtual bool open(const char* data, uint32_t size, const char* rpath, bool copy) { return false; }
     virtual bool resize(Paint* paint, float w, float h) { return false; }
     virtual void sync() {};  //finish immediately if any async update jobs.
+    virtual void memory(TVG_UNUSED RenderMemory& out) {}  //report the retained memory
 
     virtual bool read()
     {
@@ -98,6 +99,11 @@ struct ImageLoader : LoadModule
         if (surface.data) return &surface;
         return nullptr;
     }
+
+    void memory(RenderMemory& out) override
+    {
+        if (surface.data) out[MemoryType::Image] += surface.stride * surface.h * surface.channelSize;
+    }
 };
 
 
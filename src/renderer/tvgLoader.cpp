@@ -451,3 +451,10 @@ LoadModule* LoaderMgr::anyfont()
     }
     return nullptr;
 }
+
+
+void LoaderMgr::memory(RenderMemory& out)
+{
+    ScopedLock lock(_key);
+    INLIST_FOREACH(_activeLoaders, loader) loader->memory(out);
+}
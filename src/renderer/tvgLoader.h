@@ -37,6 +37,7 @@ struct LoaderMgr
     static LoadModule* anyfont();
     static bool retrieve(const char* filename);
     static bool retrieve(LoadModule* loader);
+    static void memory(RenderMemory& out);
 };
 
 #endif //_TVG_LOADER_H_
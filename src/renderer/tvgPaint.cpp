@@ -166,6 +166,7 @@ Paint* Paint::Impl::duplicate(Paint* ret)
     ret->pImpl->mark(RenderUpdateFlag::Transform);
 
     ret->pImpl->opacity = opacity;
+    ret->pImpl->blend(blendMethod);
 
     if (maskData) ret->mask(maskData->target->duplicate(), maskData->method);
     if (clipper) ret->clip(static_cast<Shape*>(clipper->duplicate()));
@@ -203,6 +204,64 @@ bool Paint::Impl::render(RenderMethod* renderer)
 }
 
 
+bool Paint::Impl::prepare()
+{
+    if (clipper) PAINT(clipper)->prepare();
+    if (maskData) PAINT(maskData->target)->prepare();
+
+    bool ret;
+    PAINT_METHOD(ret, prepare());
+    return ret;
+}
+
+
+bool Paint::Impl::memory(RenderMemory& out)
+{
+    if (renderer && rd) renderer->memory(rd, out);
+    if (clipper) PAINT(clipper)->memory(out);
+    if (maskData) PAINT(maskData->target)->memory(out);
+
+    bool ret;
+    PAINT_METHOD(ret, memory(out));
+    return ret;
+}
+
+
+//invisible: release the render data of the subtree since none of it can be drawn
+bool Paint::Impl::purge(bool invisible)
+{
+    if (opacity == 0) invisible = true;
+
+    if (invisible) {
+        if (renderer && rd) renderer->purge(rd);
+        if (clipper) PAINT(clipper)->purge(true);
+        if (maskData) PAINT(maskData->target)->purge(true);
+    }
+
+    bool ret;
+    PAINT_METHOD(ret, purge(invisible));
+    return ret;
+}
+
+
+/* Mark the paints prepared in the lower quality than the given level to be prepared again by the next update.
+   Returns whether the subtree has any of them, so the owners which skip the unchanged updates are visited as well. */
+bool Paint::Impl::refine(uint8_t level)
+{
+    if (!renderer) return false;
+
+    bool ret;
+    PAINT_METHOD(ret, refine(level));
+
+    auto masked = false;
+    if (clipper && PAINT(clipper)->refine(level)) masked = true;
+    if (maskData && PAINT(maskData->target)->refine(level)) masked = true;
+    if (masked) mark(RenderUpdateFlag::Clip);
+
+    return ret || masked;
+}
+
+
 RenderData Paint::Impl::update(RenderMethod* renderer, const Matrix& pm, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, bool clipper)
 {
     bool ret;
@@ -380,6 +439,13 @@ Paint* Paint::duplicate() const noexcept
 }
 
 
+Result Paint::prepare() noexcept
+{
+    if (pImpl->prepare()) return Result::Success;
+    return Result::InsufficientCondition;
+}
+
+
 Result Paint::clip(Shape* clipper) noexcept
 {
     return pImpl->clip(clipper);
@@ -151,7 +151,11 @@ namespace tvg
 
         bool transform(const Matrix& m)
         {
-            if (&tr.m != &m) tr.m = m;
+            if (&tr.m != &m) {
+                //the same matrix is usually re-assigned by the animations
+                if (tr.overriding && !memcmp(&tr.m, &m, sizeof(Matrix))) return true;
+                tr.m = m;
+            }
             tr.overriding = true;
             mark(RenderUpdateFlag::Transform);
 
@@ -291,6 +295,10 @@ namespace tvg
         Result bounds(Point* pt4, Matrix* pm, bool obb, bool stroking);
         RenderData update(RenderMethod* renderer, const Matrix& pm, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag pFlag, bool clipper = false);
         bool render(RenderMethod* renderer);
+        bool prepare();
+        bool memory(RenderMemory& out);
+        bool purge(bool invisible);
+        bool refine(uint8_t level);
         Paint* duplicate(Paint* ret = nullptr);
     };
 }
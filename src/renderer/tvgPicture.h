@@ -64,6 +64,7 @@ struct PictureImpl : Picture
     RenderSurface* bitmap = nullptr;  //bitmap picture uses
     float w = 0, h = 0;
     bool resizing = false;
+    bool changed = false;             //the vector scene has changed itself, e.g. the animation frames
 
     PictureImpl() : impl(Paint::Impl(this))
     {
@@ -75,9 +76,42 @@ struct PictureImpl : Picture
         delete(vector);
     }
 
+    bool prepare()
+    {
+        load();
+        if (vector) PAINT(vector)->prepare();
+        return true;
+    }
+
+    bool memory(RenderMemory& out)
+    {
+        if (loader) loader->memory(out);
+        if (vector) PAINT(vector)->memory(out);
+        return true;
+    }
+
+    bool purge(bool invisible)
+    {
+        if (vector) PAINT(vector)->purge(invisible);
+        return true;
+    }
+
+    bool refine(uint8_t level)
+    {
+        if (!vector || !PAINT(vector)->refine(level)) return false;
+        changed = true;
+        return true;
+    }
+
+    //the vector scene might be still prepared by the renderer when the loader rebuilds it
+    void wait()
+    {
+        if (vector && impl.renderer) impl.renderer->wait();
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
-        if (flag == RenderUpdateFlag::None) return true;
+        if (flag == RenderUpdateFlag::None && !changed) return true;
         return false;
     }
 
@@ -93,6 +127,7 @@ struct PictureImpl : Picture
             auto m = transform * Matrix{scale, 0, 0, 0, scale, 0, 0, 0, 1};
             impl.rd = renderer->prepare(bitmap, impl.rd, m, clips, opacity, flag);
         } else if (vector) {
+            changed = false;
             if (resizing) {
                 loader->resize(vector, w, h);
                 resizing = false;
@@ -54,11 +54,23 @@ bool RenderMethod::viewport(const RenderRegion& vp)
 }
 
 
+uint8_t RenderMethod::quality()
+{
+    return level;
+}
+
+
+void RenderMethod::quality(uint8_t level)
+{
+    this->level = level;
+}
+
+
 /************************************************************************/
 /* RenderPath Class Implementation                                      */
 /************************************************************************/
 
-bool RenderPath::bounds(Matrix* m, float* x, float* y, float* w, float* h)
+bool RenderPath::bounds(Matrix* m, float* x, float* y, float* w, float* h) const
 {
     //unexpected
     if (cmds.empty() || cmds.first() == PathCommand::CubicTo) return false;
@@ -385,4 +397,19 @@ bool RenderTrimPath::trim(const RenderPath& in, RenderPath& out) const
     }
 
     return out.pts.count >= 2;
-}
\ No newline at end of file
+}
+
+/************************************************************************/
+/* RenderShape Class Implementation                                     */
+/************************************************************************/
+
+const RenderPath* RenderShape::trimmedPath() const
+{
+    if (trimmed.dirty || trimmed.version != path.version) {
+        trimmed.path.clear();
+        trimmed.valid = stroke->trim.trim(*path, trimmed.path);
+        trimmed.version = path.version;
+        trimmed.dirty = false;
+    }
+    return trimmed.valid ? &trimmed.path : nullptr;
+}
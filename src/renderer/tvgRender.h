@@ -24,6 +24,7 @@
 #define _TVG_RENDER_H_
 
 #include <math.h>
+#include <atomic>
 #include <cstdarg>
 #include "tvgCommon.h"
 #include "tvgArray.h"
@@ -40,6 +41,9 @@ using pixel_t = uint32_t;
 enum RenderUpdateFlag : uint16_t {None = 0, Path = 1, Color = 2, Gradient = 4, Stroke = 8, Transform = 16, Image = 32, GradientStroke = 64, Blend = 128, Clip = 256, All = 0xffff};
 enum CompositionFlag : uint8_t {Invalid = 0, Opacity = 1, Blending = 2, Masking = 4, PostProcessing = 8};  //Composition Purpose
 
+//the quality levels lowered one by one while the frames overrun the canvas budget, each keeps the lower ones
+enum RenderQuality : uint8_t {FullQuality = 0, CoarseFrame, CoarseBlur, NoAntialias};
+
 static inline void operator|=(RenderUpdateFlag& a, const RenderUpdateFlag b)
 {
     a = RenderUpdateFlag(uint16_t(a) | uint16_t(b));
@@ -152,7 +156,115 @@ struct RenderPath
         cmds.clear();
     }
 
-    bool bounds(Matrix* m, float* x, float* y, float* w, float* h);
+    bool bounds(Matrix* m, float* x, float* y, float* w, float* h) const;
+};
+
+/* Copy-on-write RenderPath. The copies share the path data until
+   one of them requests it for modification via edit().
+   The data may also refer to caller-owned buffers (borrowed) which are
+   never written nor freed. edit() copies them into owned storage first. */
+struct RenderSharedPath
+{
+    struct Data
+    {
+        RenderPath path;
+        atomic<uint32_t> refCnt{1};  //the sharing shapes could be built on the different threads
+        bool borrowed = false;
+
+        ~Data()
+        {
+            if (borrowed) {
+                path.cmds.data = nullptr;
+                path.pts.data = nullptr;
+            }
+        }
+    } *data;
+    uint32_t version = 0;   //increased whenever this path data is changed
+
+    RenderSharedPath() : data(new Data) {}
+
+    RenderSharedPath(const RenderSharedPath& rhs) : data(rhs.data)
+    {
+        ++data->refCnt;
+    }
+
+    ~RenderSharedPath()
+    {
+        unref();
+    }
+
+    RenderSharedPath& operator=(const RenderSharedPath& rhs)
+    {
+        if (data == rhs.data) return *this;
+        unref();
+        data = rhs.data;
+        ++data->refCnt;
+        ++version;
+        return *this;
+    }
+
+    const RenderPath* operator->() const
+    {
+        return &data->path;
+    }
+
+    const RenderPath& operator*() const
+    {
+        return data->path;
+    }
+
+    RenderPath& edit()
+    {
+        if (data->refCnt > 1 || data->borrowed) {
+            auto dup = new Data;
+            dup->path.cmds.push(data->path.cmds);
+            dup->path.pts.push(data->path.pts);
+            unref();
+            data = dup;
+        }
+        ++version;
+        return data->path;
+    }
+
+    void clear()
+    {
+        //detach without copying the data to be discarded
+        if (data->refCnt > 1 || data->borrowed) {
+            unref();
+            data = new Data;
+        } else data->path.clear();
+        ++version;
+    }
+
+    //refer to the given buffers without copying, they must outlive this path data.
+    void borrow(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt)
+    {
+        if (data->refCnt > 1 || !data->borrowed) {
+            unref();
+            data = new Data;
+            data->borrowed = true;
+        }
+        data->path.cmds.data = const_cast<PathCommand*>(cmds);
+        data->path.cmds.count = data->path.cmds.reserved = cmdCnt;
+        data->path.pts.data = const_cast<Point*>(pts);
+        data->path.pts.count = data->path.pts.reserved = ptsCnt;
+        ++version;
+    }
+
+    bool shared() const
+    {
+        return data->refCnt > 1;
+    }
+
+    bool borrowed() const
+    {
+        return data->borrowed;
+    }
+
+    void unref()
+    {
+        if (--data->refCnt == 0) delete(data);
+    }
 };
 
 struct RenderTrimPath
@@ -186,6 +298,7 @@ struct RenderStroke
     StrokeCap cap = StrokeCap::Square;
     StrokeJoin join = StrokeJoin::Bevel;
     bool first = false;
+    uint32_t refCnt = 1;    //shared by the duplicated shapes, copy on write
 
     void operator=(const RenderStroke& rhs)
     {
@@ -220,18 +333,56 @@ struct RenderStroke
     }
 };
 
+struct RenderInstance
+{
+    Matrix m;
+    RenderColor color;
+    uint8_t opacity;
+};
+
 struct RenderShape
 {
-    RenderPath path;
+    RenderSharedPath path;
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
+    Array<RenderInstance> instances;   //optional, draws the shape once per instance
     FillRule rule = FillRule::NonZero;
+    bool instanceColors = false;       //instances override the fill color
+
+    //the trimmed path, cached until the path or the stroke is changed
+    mutable struct {
+        RenderPath path;
+        uint32_t version = 0;
+        bool valid = false;
+        bool dirty = true;
+    } trimmed;
 
     ~RenderShape()
     {
         delete(fill);
-        delete(stroke);
+        releaseStroke();
+    }
+
+    void releaseStroke()
+    {
+        if (stroke && --stroke->refCnt == 0) delete(stroke);
+        stroke = nullptr;
+        trimmed.dirty = true;
+    }
+
+    //exclusive stroke for modification
+    RenderStroke* editStroke()
+    {
+        trimmed.dirty = true;
+        if (!stroke) stroke = new RenderStroke;
+        else if (stroke->refCnt > 1) {
+            auto dup = new RenderStroke;
+            *dup = *stroke;
+            --stroke->refCnt;
+            stroke = dup;
+        }
+        return stroke;
     }
 
     void fillColor(uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) const
@@ -248,6 +399,8 @@ struct RenderShape
         return stroke->trim.valid();
     }
 
+    const RenderPath* trimmedPath() const;   //nullptr if nothing remains after the trimming
+
     bool strokeFirst() const
     {
         return (stroke && stroke->first) ? true : false;
@@ -302,6 +455,17 @@ struct RenderShape
         if (!stroke) return 4.0f;
         return stroke->miterlimit;;
     }
+
+    bool instanced() const
+    {
+        return instances.count > 0;
+    }
+
+    RenderColor instanceColor(uint32_t idx) const
+    {
+        if (instanceColors) return instances[idx].color;
+        return color;
+    }
 };
 
 struct RenderEffect
@@ -312,6 +476,17 @@ struct RenderEffect
     bool valid = false;
 
     virtual ~RenderEffect() {}
+    virtual RenderEffect* duplicate() const = 0;
+
+protected:
+    //the duplicated one is prepared by the renderer again
+    static RenderEffect* clone(RenderEffect* dup)
+    {
+        dup->rd = nullptr;
+        dup->extend = {};
+        dup->valid = false;
+        return dup;
+    }
 };
 
 struct RenderEffectGaussianBlur : RenderEffect
@@ -331,6 +506,11 @@ struct RenderEffectGaussianBlur : RenderEffect
         inst->type = SceneEffect::GaussianBlur;
         return inst;
     }
+
+    RenderEffect* duplicate() const override
+    {
+        return clone(new RenderEffectGaussianBlur(*this));
+    }
 };
 
 struct RenderEffectDropShadow : RenderEffect
@@ -355,6 +535,11 @@ struct RenderEffectDropShadow : RenderEffect
         inst->type = SceneEffect::DropShadow;
         return inst;
     }
+
+    RenderEffect* duplicate() const override
+    {
+        return clone(new RenderEffectDropShadow(*this));
+    }
 };
 
 struct RenderEffectFill : RenderEffect
@@ -371,6 +556,11 @@ struct RenderEffectFill : RenderEffect
         inst->type = SceneEffect::Fill;
         return inst;
     }
+
+    RenderEffect* duplicate() const override
+    {
+        return clone(new RenderEffectFill(*this));
+    }
 };
 
 struct RenderEffectTint : RenderEffect
@@ -392,6 +582,11 @@ struct RenderEffectTint : RenderEffect
         inst->type = SceneEffect::Tint;
         return inst;
     }
+
+    RenderEffect* duplicate() const override
+    {
+        return clone(new RenderEffectTint(*this));
+    }
 };
 
 struct RenderEffectTritone : RenderEffect
@@ -415,6 +610,29 @@ struct RenderEffectTritone : RenderEffect
         inst->type = SceneEffect::Tritone;
         return inst;
     }
+
+    RenderEffect* duplicate() const override
+    {
+        return clone(new RenderEffectTritone(*this));
+    }
+};
+
+struct RenderMemory
+{
+    size_t usage[6] = {};   //indexed by MemoryType
+
+    size_t& operator[](MemoryType type)
+    {
+        return usage[int(type)];
+    }
+
+    size_t get(MemoryType type) const
+    {
+        if (type != MemoryType::All) return usage[int(type)];
+        size_t sum = 0;
+        for (int i = 1; i < 6; ++i) sum += usage[i];
+        return sum;
+    }
 };
 
 class RenderMethod
@@ -425,6 +643,7 @@ private:
 
 protected:
     RenderRegion vport;         //viewport
+    uint8_t level = FullQuality;   //the quality lowered by the frame budget
 
 public:
     //common implementation
@@ -432,6 +651,8 @@ public:
     uint32_t unref();
     RenderRegion viewport();
     bool viewport(const RenderRegion& vp);
+    uint8_t quality();
+    void quality(uint8_t level);
 
     //main features
     virtual ~RenderMethod() {}
@@ -462,6 +683,18 @@ public:
     virtual bool region(RenderEffect* effect) = 0;
     virtual bool render(RenderCompositor* cmp, const RenderEffect* effect, bool direct) = 0;
     virtual void dispose(RenderEffect* effect) = 0;
+
+    //memory accounting, optional
+    virtual void memory(TVG_UNUSED RenderData data, TVG_UNUSED RenderMemory& out) {}
+    virtual void memory(TVG_UNUSED RenderMemory& out) {}
+    virtual void purge(TVG_UNUSED RenderData data) {}
+    virtual void purge() {}
+
+    //finish the pending jobs referring to the paints before those are modified, optional
+    virtual void wait() {}
+
+    //the shape instances are drawn, otherwise the instanced shape is drawn once, optional
+    virtual bool instancing() { return false; }
 };
 
 static inline bool MASK_REGION_MERGING(MaskMethod method)
@@ -67,6 +67,7 @@ struct SceneImpl : Scene
     RenderRegion vport = {};
     Array<RenderEffect*>* effects = nullptr;
     uint8_t opacity;         //for composition
+    uint8_t quality = FullQuality;   //of the prepared effects
     bool vdirty = false;
 
     SceneImpl() : impl(Paint::Impl(this))
@@ -102,6 +103,35 @@ struct SceneImpl : Scene
         return 1;
     }
 
+    bool prepare()
+    {
+        for (auto paint : paints) PAINT(paint)->prepare();
+        return true;
+    }
+
+    bool memory(RenderMemory& out)
+    {
+        for (auto paint : paints) PAINT(paint)->memory(out);
+        return true;
+    }
+
+    bool purge(bool invisible)
+    {
+        for (auto paint : paints) PAINT(paint)->purge(invisible);
+        return true;
+    }
+
+    bool refine(uint8_t level)
+    {
+        auto ret = false;
+        for (auto paint : paints) {
+            if (PAINT(paint)->refine(level)) ret = true;
+        }
+        //the effects are prepared again whenever this scene is visited
+        if (effects && quality > level) ret = true;
+        return ret;
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
         return false;
@@ -125,6 +155,7 @@ struct SceneImpl : Scene
             ARRAY_FOREACH(p, *effects) {
                 renderer->prepare(*p, transform);
             }
+            quality = renderer->quality();
         }
 
         //this viewport update is more performant than in bounds()?
@@ -248,7 +279,11 @@ struct SceneImpl : Scene
             dup->paints.push_back(cdup);
         }
 
-        if (effects) TVGERR("RENDERER", "TODO: Duplicate Effects?");
+        if (effects) {
+            dup->effects = new Array<RenderEffect*>;
+            dup->effects->reserve(effects->count);
+            ARRAY_FOREACH(p, *effects) dup->effects->push((*p)->duplicate());
+        }
 
         return scene;
     }
@@ -305,7 +340,7 @@ struct SceneImpl : Scene
     {
         if (effects) {
             ARRAY_FOREACH(p, *effects) {
-                impl.renderer->dispose(*p);
+                if (impl.renderer) impl.renderer->dispose(*p);
                 delete(*p);
             }
             delete(effects);
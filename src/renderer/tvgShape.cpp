@@ -48,11 +48,11 @@ Result Shape::reset() noexcept
 
 Result Shape::path(const PathCommand** cmds, uint32_t* cmdsCnt, const Point** pts, uint32_t* ptsCnt) const noexcept
 {
-    if (cmds) *cmds = CONST_SHAPE(this)->rs.path.cmds.data;
-    if (cmdsCnt) *cmdsCnt = CONST_SHAPE(this)->rs.path.cmds.count;
+    if (cmds) *cmds = CONST_SHAPE(this)->rs.path->cmds.data;
+    if (cmdsCnt) *cmdsCnt = CONST_SHAPE(this)->rs.path->cmds.count;
 
-    if (pts) *pts = CONST_SHAPE(this)->rs.path.pts.data;
-    if (ptsCnt) *ptsCnt = CONST_SHAPE(this)->rs.path.pts.count;
+    if (pts) *pts = CONST_SHAPE(this)->rs.path->pts.data;
+    if (ptsCnt) *ptsCnt = CONST_SHAPE(this)->rs.path->pts.count;
 
     return Result::Success;
 }
@@ -64,6 +64,12 @@ Result Shape::appendPath(const PathCommand *cmds, uint32_t cmdCnt, const Point*
 }
 
 
+Result Shape::borrowPath(const PathCommand *cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt) noexcept
+{
+    return SHAPE(this)->borrowPath(cmds, cmdCnt, pts, ptsCnt);
+}
+
+
 Result Shape::moveTo(float x, float y) noexcept
 {
     SHAPE(this)->moveTo(x, y);
@@ -139,6 +145,12 @@ Result Shape::order(bool strokeFirst) noexcept
 }
 
 
+Result Shape::instances(const Matrix* transforms, uint32_t cnt, const uint8_t* colors, const uint8_t* opacities) noexcept
+{
+    return SHAPE(this)->instances(transforms, cnt, colors, opacities);
+}
+
+
 Result Shape::strokeWidth(float width) noexcept
 {
     SHAPE(this)->strokeWidth(width);
@@ -25,6 +25,7 @@
 
 #include "tvgCommon.h"
 #include "tvgMath.h"
+#include "tvgFill.h"
 #include "tvgPaint.h"
 
 #define SHAPE(A) static_cast<ShapeImpl*>(A)
@@ -36,10 +37,109 @@ struct ShapeImpl : Shape
     RenderShape rs;
     uint8_t opacity;    //for composition
 
+    //the digests of the last prepared properties to filter out the redundant update requests
+    struct {
+        uint64_t path;
+        uint64_t stroke;
+        uint64_t fill;
+        uint64_t strokeFill;
+        uint32_t version;       //of the path, the same version is the same path unless it's borrowed
+        Matrix transform;
+        RenderRegion vport;
+        RenderColor color;
+        RenderTrimPath trim;
+        FillRule rule;
+        uint8_t opacity;
+        uint8_t quality;        //the antialiasing is dropped in the lowered quality
+        bool clipper;
+        bool clipped;
+        bool valid = false;
+    } prepared;
+
     ShapeImpl() : impl(Paint::Impl(this))
     {
     }
 
+    void invalidate()
+    {
+        prepared.valid = false;
+    }
+
+    uint64_t pathHash() const
+    {
+        //the borrowed buffers might have been modified by the caller
+        if (prepared.valid && prepared.version == rs.path.version && !rs.path.data->borrowed) return prepared.path;
+        auto& path = *rs.path;
+        auto hash = fnv1aEncode(path.cmds.data, sizeof(PathCommand) * path.cmds.count);
+        return fnv1aEncode(path.pts.data, sizeof(Point) * path.pts.count, hash);
+    }
+
+    //the stroke properties except the fill and the trimming
+    uint64_t strokeHash() const
+    {
+        auto stroke = rs.stroke;
+        if (!stroke) return 0;
+        auto hash = fnv1aEncode(&stroke->width, sizeof(stroke->width));
+        hash = fnv1aEncode(&stroke->color, sizeof(stroke->color), hash);
+        hash = fnv1aEncode(&stroke->miterlimit, sizeof(stroke->miterlimit), hash);
+        hash = fnv1aEncode(&stroke->cap, sizeof(stroke->cap), hash);
+        hash = fnv1aEncode(&stroke->join, sizeof(stroke->join), hash);
+        hash = fnv1aEncode(&stroke->first, sizeof(stroke->first), hash);
+        hash = fnv1aEncode(&stroke->dash.count, sizeof(stroke->dash.count), hash);
+        hash = fnv1aEncode(&stroke->dash.offset, sizeof(stroke->dash.offset), hash);
+        return fnv1aEncode(stroke->dash.pattern, sizeof(float) * stroke->dash.count, hash);
+    }
+
+    /* Drop the requested flags whose properties are the same as the last prepared ones,
+       so the retained shapes which are re-assigned with the same values every frame
+       don't regenerate their render data. Only the digests are kept, the live buffers
+       are not referred to. The clipped results can't be reused partially. */
+    RenderUpdateFlag filter(RenderMethod* renderer, const Matrix& transform, const Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, bool clipper)
+    {
+        auto vport = renderer->viewport();
+        auto path = pathHash();
+        auto stroke = strokeHash();
+        auto fill = tvg::hash(rs.fill);
+        auto strokeFill = tvg::hash(rs.strokeFill());
+        RenderTrimPath trim;
+        if (rs.stroke) trim = rs.stroke->trim;
+
+        if (prepared.valid && impl.rd && flag != RenderUpdateFlag::All && clips.empty() && !rs.instanced() &&
+            prepared.clipper == clipper && prepared.opacity == opacity && prepared.vport == vport && prepared.quality == renderer->quality()) {
+            auto ret = RenderUpdateFlag(flag & (RenderUpdateFlag::Blend | RenderUpdateFlag::Image));
+            //the viewport clipping is compared already
+            if ((flag & RenderUpdateFlag::Clip) && prepared.clipped) ret |= RenderUpdateFlag::Clip;
+            auto rule = prepared.rule != rs.rule;
+            auto trimmed = prepared.trim.begin != trim.begin || prepared.trim.end != trim.end || prepared.trim.simultaneous != trim.simultaneous;
+            if ((flag & RenderUpdateFlag::Path) && (rule || trimmed || prepared.path != path)) ret |= RenderUpdateFlag::Path;
+            if ((flag & RenderUpdateFlag::Color) && (rule || memcmp(&prepared.color, &rs.color, sizeof(RenderColor)))) ret |= RenderUpdateFlag::Color;
+            if ((flag & RenderUpdateFlag::Gradient) && prepared.fill != fill) ret |= RenderUpdateFlag::Gradient;
+            if ((flag & RenderUpdateFlag::Stroke) && prepared.stroke != stroke) ret |= RenderUpdateFlag::Stroke;
+            if ((flag & RenderUpdateFlag::GradientStroke) && prepared.strokeFill != strokeFill) ret |= RenderUpdateFlag::GradientStroke;
+            if ((flag & RenderUpdateFlag::Transform) && memcmp(&prepared.transform, &transform, sizeof(Matrix))) ret |= RenderUpdateFlag::Transform;
+            flag = ret;
+        }
+
+        //keep the current properties
+        prepared.path = path;
+        prepared.stroke = stroke;
+        prepared.fill = fill;
+        prepared.strokeFill = strokeFill;
+        prepared.version = rs.path.version;
+        prepared.transform = transform;
+        prepared.vport = vport;
+        prepared.color = rs.color;
+        prepared.trim = trim;
+        prepared.rule = rs.rule;
+        prepared.opacity = opacity;
+        prepared.quality = renderer->quality();
+        prepared.clipper = clipper;
+        prepared.clipped = !clips.empty();
+        prepared.valid = true;
+
+        return flag;
+    }
+
     bool render(RenderMethod* renderer)
     {
         if (!impl.rd) return false;
@@ -94,6 +194,31 @@ struct ShapeImpl : Shape
         return true;
     }
 
+    bool prepare()
+    {
+        if (rs.trimpath()) rs.trimmedPath();
+        return true;
+    }
+
+    bool memory(TVG_UNUSED RenderMemory& out)
+    {
+        return true;
+    }
+
+    bool purge(bool invisible)
+    {
+        //the purged render data must be regenerated entirely
+        if (invisible) invalidate();
+        return true;
+    }
+
+    bool refine(uint8_t level)
+    {
+        if (!impl.rd || !prepared.valid || prepared.quality <= level) return false;
+        impl.mark(RenderUpdateFlag::Path | RenderUpdateFlag::Stroke);
+        return true;
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
         if (flag == RenderUpdateFlag::None) return true;
@@ -109,6 +234,9 @@ struct ShapeImpl : Shape
             opacity = 255;
         }
 
+        flag = filter(renderer, transform, clips, opacity, flag, clipper);
+        if (flag == RenderUpdateFlag::None) return true;
+
         impl.rd = renderer->prepare(rs, impl.rd, transform, clips, opacity, flag, clipper);
         return true;
     }
@@ -120,8 +248,10 @@ struct ShapeImpl : Shape
 
     Result bounds(Point* pt4, Matrix& m, bool obb, bool stroking)
     {
+        if (rs.instanced()) return instanceBounds(pt4, m, obb, stroking);
+
         float x, y, w, h;
-        if (!rs.path.bounds(obb ? nullptr : &m, &x, &y, &w, &h)) return Result::InsufficientCondition;
+        if (!rs.path->bounds(obb ? nullptr : &m, &x, &y, &w, &h)) return Result::InsufficientCondition;
 
         //Stroke feathering
         if (stroking && rs.stroke) {
@@ -146,49 +276,111 @@ struct ShapeImpl : Shape
         return Result::Success;
     }
 
+    Result instanceBounds(Point* pt4, Matrix& m, bool obb, bool stroking)
+    {
+        Point min = {FLT_MAX, FLT_MAX};
+        Point max = {-FLT_MAX, -FLT_MAX};
+        auto half = (stroking && rs.stroke) ? rs.stroke->width * 0.5f : 0.0f;
+
+        //Merge the boundaries of all instances, in the object space for the oriented box
+        ARRAY_FOREACH(p, rs.instances) {
+            auto im = obb ? p->m : m * p->m;
+            float x, y, w, h;
+            if (!rs.path->bounds(&im, &x, &y, &w, &h)) return Result::InsufficientCondition;
+            if (x - half < min.x) min.x = x - half;
+            if (y - half < min.y) min.y = y - half;
+            if (x + w + half > max.x) max.x = x + w + half;
+            if (y + h + half > max.y) max.y = y + h + half;
+        }
+
+        pt4[0] = min;
+        pt4[1] = {max.x, min.y};
+        pt4[2] = max;
+        pt4[3] = {min.x, max.y};
+
+        if (obb) {
+            pt4[0] *= m;
+            pt4[1] *= m;
+            pt4[2] *= m;
+            pt4[3] *= m;
+        }
+
+        return Result::Success;
+    }
+
+    Result instances(const Matrix* transforms, uint32_t cnt, const uint8_t* colors, const uint8_t* opacities)
+    {
+        if (!transforms && cnt > 0) return Result::InvalidArguments;
+
+        rs.instances.clear();
+        rs.instanceColors = (colors && cnt > 0);
+
+        if (cnt > 0) {
+            rs.instances.reserve(cnt);
+            for (uint32_t i = 0; i < cnt; ++i) {
+                auto& inst = rs.instances.next();
+                inst.m = transforms[i];
+                if (colors) inst.color = {colors[i * 4], colors[i * 4 + 1], colors[i * 4 + 2], colors[i * 4 + 3]};
+                else inst.color = rs.color;
+                inst.opacity = opacities ? opacities[i] : 255;
+            }
+        }
+
+        impl.mark(RenderUpdateFlag::Path | RenderUpdateFlag::Color);
+
+        return Result::Success;
+    }
+
     void reserveCmd(uint32_t cmdCnt)
     {
-        rs.path.cmds.reserve(cmdCnt);
+        auto& path = rs.path.edit();
+        path.cmds.reserve(cmdCnt);
     }
 
     void reservePts(uint32_t ptsCnt)
     {
-        rs.path.pts.reserve(ptsCnt);
+        auto& path = rs.path.edit();
+        path.pts.reserve(ptsCnt);
     }
 
     void grow(uint32_t cmdCnt, uint32_t ptsCnt)
     {
-        rs.path.cmds.grow(cmdCnt);
-        rs.path.pts.grow(ptsCnt);
+        auto& path = rs.path.edit();
+        path.cmds.grow(cmdCnt);
+        path.pts.grow(ptsCnt);
     }
 
     void append(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt)
     {
-        memcpy(rs.path.cmds.end(), cmds, sizeof(PathCommand) * cmdCnt);
-        memcpy(rs.path.pts.end(), pts, sizeof(Point) * ptsCnt);
-        rs.path.cmds.count += cmdCnt;
-        rs.path.pts.count += ptsCnt;
+        auto& path = rs.path.edit();
+        memcpy(path.cmds.end(), cmds, sizeof(PathCommand) * cmdCnt);
+        memcpy(path.pts.end(), pts, sizeof(Point) * ptsCnt);
+        path.cmds.count += cmdCnt;
+        path.pts.count += ptsCnt;
     }
 
     void moveTo(float x, float y)
     {
-        rs.path.cmds.push(PathCommand::MoveTo);
-        rs.path.pts.push({x, y});
+        auto& path = rs.path.edit();
+        path.cmds.push(PathCommand::MoveTo);
+        path.pts.push({x, y});
     }
 
     void lineTo(float x, float y)
     {
-        rs.path.cmds.push(PathCommand::LineTo);
-        rs.path.pts.push({x, y});
+        auto& path = rs.path.edit();
+        path.cmds.push(PathCommand::LineTo);
+        path.pts.push({x, y});
         impl.mark(RenderUpdateFlag::Path);
     }
 
     void cubicTo(float cx1, float cy1, float cx2, float cy2, float x, float y)
     {
-        rs.path.cmds.push(PathCommand::CubicTo);
-        rs.path.pts.push({cx1, cy1});
-        rs.path.pts.push({cx2, cy2});
-        rs.path.pts.push({x, y});
+        auto& path = rs.path.edit();
+        path.cmds.push(PathCommand::CubicTo);
+        path.pts.push({cx1, cy1});
+        path.pts.push({cx2, cy2});
+        path.pts.push({x, y});
 
         impl.mark(RenderUpdateFlag::Path);
     }
@@ -196,15 +388,16 @@ struct ShapeImpl : Shape
     void close()
     {
         //Don't close multiple times.
-        if (rs.path.cmds.count > 0 && rs.path.cmds.last() == PathCommand::Close) return;
-        rs.path.cmds.push(PathCommand::Close);
+        auto& path = rs.path.edit();
+        if (path.cmds.count > 0 && path.cmds.last() == PathCommand::Close) return;
+        path.cmds.push(PathCommand::Close);
         impl.mark(RenderUpdateFlag::Path);
     }
 
     void strokeWidth(float width)
     {
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        rs.stroke->width = width;
+        auto stroke = rs.editStroke();
+        stroke->width = width;
         impl.mark(RenderUpdateFlag::Stroke);
     }
 
@@ -212,12 +405,9 @@ struct ShapeImpl : Shape
     {
         if (!rs.stroke) {
             if (trim.begin == 0.0f && trim.end == 1.0f) return;
-            rs.stroke = new RenderStroke();
-        }
-
-        if (tvg::equal(rs.stroke->trim.begin, trim.begin) && tvg::equal(rs.stroke->trim.end, trim.end) && rs.stroke->trim.simultaneous == trim.simultaneous) return;
+        } else if (tvg::equal(rs.stroke->trim.begin, trim.begin) && tvg::equal(rs.stroke->trim.end, trim.end) && rs.stroke->trim.simultaneous == trim.simultaneous) return;
 
-        rs.stroke->trim = trim;
+        rs.editStroke()->trim = trim;
         impl.mark(RenderUpdateFlag::Path);
     }
 
@@ -236,15 +426,15 @@ struct ShapeImpl : Shape
 
     void strokeCap(StrokeCap cap)
     {
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        rs.stroke->cap = cap;
+        auto stroke = rs.editStroke();
+        stroke->cap = cap;
         impl.mark(RenderUpdateFlag::Stroke);
     }
 
     void strokeJoin(StrokeJoin join)
     {
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        rs.stroke->join = join;
+        auto stroke = rs.editStroke();
+        stroke->join = join;
         impl.mark(RenderUpdateFlag::Stroke);
     }
 
@@ -253,8 +443,8 @@ struct ShapeImpl : Shape
         // https://www.w3.org/TR/SVG2/painting.html#LineJoin
         // - A negative value for stroke-miterlimit must be treated as an illegal value.
         if (miterlimit < 0.0f) return Result::InvalidArguments;
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        rs.stroke->miterlimit = miterlimit;
+        auto stroke = rs.editStroke();
+        stroke->miterlimit = miterlimit;
         impl.mark(RenderUpdateFlag::Stroke);
 
         return Result::Success;
@@ -262,14 +452,14 @@ struct ShapeImpl : Shape
 
     void strokeFill(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
     {
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        if (rs.stroke->fill) {
-            delete(rs.stroke->fill);
-            rs.stroke->fill = nullptr;
+        auto stroke = rs.editStroke();
+        if (stroke->fill) {
+            delete(stroke->fill);
+            stroke->fill = nullptr;
             impl.mark(RenderUpdateFlag::GradientStroke);
         }
 
-        rs.stroke->color = {r, g, b, a};
+        stroke->color = {r, g, b, a};
 
         impl.mark(RenderUpdateFlag::Stroke);
     }
@@ -278,10 +468,10 @@ struct ShapeImpl : Shape
     {
         if (!f) return Result::InvalidArguments;
 
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        if (rs.stroke->fill && rs.stroke->fill != f) delete(rs.stroke->fill);
-        rs.stroke->fill = f;
-        rs.stroke->color.a = 0;
+        auto stroke = rs.editStroke();
+        if (stroke->fill && stroke->fill != f) delete(stroke->fill);
+        stroke->fill = f;
+        stroke->color.a = 0;
 
         impl.mark(RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
 
@@ -291,9 +481,9 @@ struct ShapeImpl : Shape
     Result strokeDash(const float* pattern, uint32_t cnt, float offset)
     {
         if ((cnt == 1) || (!pattern && cnt > 0) || (pattern && cnt == 0)) return Result::InvalidArguments;
-        if (!rs.stroke) rs.stroke = new RenderStroke;
+        auto stroke = rs.editStroke();
         //Reset dash
-        auto& dash = rs.stroke->dash;
+        auto& dash = stroke->dash;
         if (dash.count != cnt) {
             tvg::free(dash.pattern);
             dash.pattern = nullptr;
@@ -310,8 +500,8 @@ struct ShapeImpl : Shape
                 dash.length += dash.pattern[i];
             }
         }
-        rs.stroke->dash.count = cnt;
-        rs.stroke->dash.offset = offset;
+        stroke->dash.count = cnt;
+        stroke->dash.offset = offset;
         impl.mark(RenderUpdateFlag::Stroke);
 
         return Result::Success;
@@ -325,8 +515,8 @@ struct ShapeImpl : Shape
 
     void strokeFirst(bool first)
     {
-        if (!rs.stroke) rs.stroke = new RenderStroke();
-        rs.stroke->first = first;
+        auto stroke = rs.editStroke();
+        stroke->first = first;
         impl.mark(RenderUpdateFlag::Stroke);
     }
 
@@ -357,8 +547,7 @@ struct ShapeImpl : Shape
 
     void resetPath()
     {
-        rs.path.cmds.clear();
-        rs.path.pts.clear();
+        rs.path.clear();
         impl.mark(RenderUpdateFlag::Path);
     }
 
@@ -373,13 +562,24 @@ struct ShapeImpl : Shape
         return Result::Success;
     }
 
+    Result borrowPath(const PathCommand *cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt)
+    {
+        if (cmdCnt == 0 || ptsCnt == 0 || !cmds || !pts) return Result::InvalidArguments;
+
+        rs.path.borrow(cmds, cmdCnt, pts, ptsCnt);
+        impl.mark(RenderUpdateFlag::Path);
+
+        return Result::Success;
+    }
+
     void appendCircle(float cx, float cy, float rx, float ry, bool cw)
     {
+        auto& path = rs.path.edit();
         auto rxKappa = rx * PATH_KAPPA;
         auto ryKappa = ry * PATH_KAPPA;
 
-        rs.path.cmds.grow(6);
-        auto cmds = rs.path.cmds.end();
+        path.cmds.grow(6);
+        auto cmds = path.cmds.end();
 
         cmds[0] = PathCommand::MoveTo;
         cmds[1] = PathCommand::CubicTo;
@@ -388,13 +588,13 @@ struct ShapeImpl : Shape
         cmds[4] = PathCommand::CubicTo;
         cmds[5] = PathCommand::Close;
 
-        rs.path.cmds.count += 6;
+        path.cmds.count += 6;
 
         int table[2][13] = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, {0, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 12}};
         int* idx = cw ? table[0] : table[1];
 
-        rs.path.pts.grow(13);
-        auto pts = rs.path.pts.end();
+        path.pts.grow(13);
+        auto pts = path.pts.end();
 
         pts[idx[0]] = {cx, cy - ry}; //moveTo
         pts[idx[1]] = {cx + rxKappa, cy - ry}; pts[idx[2]] = {cx + rx, cy - ryKappa}; pts[idx[3]] = {cx + rx, cy}; //cubicTo
@@ -402,20 +602,21 @@ struct ShapeImpl : Shape
         pts[idx[7]] = {cx - rxKappa, cy + ry}; pts[idx[8]] = {cx - rx, cy + ryKappa}; pts[idx[9]] = {cx - rx, cy}; //cubicTo
         pts[idx[10]] = {cx - rx, cy - ryKappa}; pts[idx[11]] = {cx - rxKappa, cy - ry}; pts[idx[12]] = {cx, cy - ry}; //cubicTo
 
-        rs.path.pts.count += 13;
+        path.pts.count += 13;
 
         impl.mark(RenderUpdateFlag::Path);
     }
 
     void appendRect(float x, float y, float w, float h, float rx, float ry, bool cw)
     {
+        auto& path = rs.path.edit();
         //sharp rect
         if (tvg::zero(rx) && tvg::zero(ry)) {
-            rs.path.cmds.grow(5);
-            rs.path.pts.grow(4);
+            path.cmds.grow(5);
+            path.pts.grow(4);
 
-            auto cmds = rs.path.cmds.end();
-            auto pts = rs.path.pts.end();
+            auto cmds = path.cmds.end();
+            auto pts = path.pts.end();
 
             cmds[0] = PathCommand::MoveTo;
             cmds[1] = cmds[2] = cmds[3] = PathCommand::LineTo;
@@ -431,8 +632,8 @@ struct ShapeImpl : Shape
                 pts[3] = {x + w, y + h};
             }
 
-            rs.path.cmds.count += 5;
-            rs.path.pts.count += 4;
+            path.cmds.count += 5;
+            path.pts.count += 4;
         //round rect
         } else {
             auto hsize = Point{w * 0.5f, h * 0.5f};
@@ -440,11 +641,11 @@ struct ShapeImpl : Shape
             ry = (ry > hsize.y) ? hsize.y : ry;
             auto hr = Point{rx * PATH_KAPPA, ry * PATH_KAPPA};
 
-            rs.path.cmds.grow(10);
-            rs.path.pts.grow(17);
+            path.cmds.grow(10);
+            path.pts.grow(17);
 
-            auto cmds = rs.path.cmds.end();
-            auto pts = rs.path.pts.end();
+            auto cmds = path.cmds.end();
+            auto pts = path.pts.end();
 
             cmds[0] = PathCommand::MoveTo;
             cmds[9] = PathCommand::Close;
@@ -476,8 +677,8 @@ struct ShapeImpl : Shape
                 pts[16] = {x + w, y + ry}; //line
             }
 
-            rs.path.cmds.count += 10;
-            rs.path.pts.count += 17;
+            path.cmds.count += 10;
+            path.pts.count += 17;
         }
         impl.mark(RenderUpdateFlag::Path);
     }
@@ -485,28 +686,34 @@ struct ShapeImpl : Shape
     Paint* duplicate(Paint* ret)
     {
         auto shape = static_cast<Shape*>(ret);
-        if (shape) shape->reset();
-        else shape = Shape::gen();
+
+        //Default Properties, the reused one could keep the render data of the unchanged properties
+        if (shape) {
+            shape->reset();
+            PAINT(shape)->mark(RenderUpdateFlag::Path | RenderUpdateFlag::Color | RenderUpdateFlag::Gradient | RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
+        } else {
+            shape = Shape::gen();
+            PAINT(shape)->mark(RenderUpdateFlag::All);
+        }
 
         auto dup = SHAPE(shape);
         delete(dup->rs.fill);
-
-        //Default Properties
-        dup->impl.mark(RenderUpdateFlag::All);
         dup->rs.rule = rs.rule;
         dup->rs.color = rs.color;
 
-        //Path
-        dup->rs.path.cmds.push(rs.path.cmds);
-        dup->rs.path.pts.push(rs.path.pts);
+        //Path, shared until either one is modified. The borrowed one is copied not to extend the caller's buffer lifetime.
+        dup->rs.path = rs.path;
+        if (rs.path.borrowed()) dup->rs.path.edit();
+
+        //Instances
+        dup->rs.instances = rs.instances;
+        dup->rs.instanceColors = rs.instanceColors;
 
-        //Stroke
+        //Stroke, shared until either one is modified
+        dup->rs.releaseStroke();
         if (rs.stroke) {
-            if (!dup->rs.stroke) dup->rs.stroke = new RenderStroke;
-            *dup->rs.stroke = *rs.stroke;
-        } else {
-            delete(dup->rs.stroke);
-            dup->rs.stroke = nullptr;
+            ++rs.stroke->refCnt;
+            dup->rs.stroke = rs.stroke;
         }
 
         //Fill
@@ -519,14 +726,15 @@ struct ShapeImpl : Shape
     void reset()
     {
         PAINT(this)->reset();
-        rs.path.cmds.clear();
-        rs.path.pts.clear();
+        rs.path.clear();
 
         rs.color.a = 0;
         rs.rule = FillRule::NonZero;
 
-        delete(rs.stroke);
-        rs.stroke = nullptr;
+        rs.instances.clear();
+        rs.instanceColors = false;
+
+        rs.releaseStroke();
 
         delete(rs.fill);
         rs.fill = nullptr;
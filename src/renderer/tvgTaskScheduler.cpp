@@ -33,6 +33,9 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
+//a worker waiting for its own requests could be stuck behind the other busy workers
+static thread_local bool _inplace = false;
+
 struct TaskQueue {
     Inlist<Task>             taskDeque;
     mutex                    mtx;
@@ -148,7 +151,7 @@ struct TaskSchedulerImpl
     void request(Task* task)
     {
         //Async
-        if (threads.count > 0) {
+        if (threads.count > 0 && !_inplace) {
             task->prepare();
             auto i = idx++;
             for (uint32_t n = 0; n < threads.count; ++n) {
@@ -209,6 +212,18 @@ void TaskScheduler::request(Task* task)
 }
 
 
+bool TaskScheduler::inplace(TVG_UNUSED bool on)
+{
+#ifdef THORVG_THREAD_SUPPORT
+    auto former = _inplace;
+    _inplace = on;
+    return former;
+#else
+    return true;
+#endif
+}
+
+
 uint32_t TaskScheduler::threads()
 {
     return _inst ? _inst->threadCnt() : 0;
@@ -112,6 +112,7 @@ struct TaskScheduler
     static void init(uint32_t threads);
     static void term();
     static void request(Task* task);
+    static bool inplace(bool on);  //run the tasks requested by this thread on it, returns the former setting
     static bool onthread();  //figure out whether on worker thread or not
     static ThreadID tid();
 };
@@ -41,6 +41,7 @@ struct TextImpl : Text
     char* utf8 = nullptr;
     float fontSize;
     bool italic = false;
+    bool changed = false;   //the text shape needs to be reloaded
 
     TextImpl() : impl(Paint::Impl(this)), shape(Shape::gen())
     {
@@ -62,6 +63,7 @@ struct TextImpl : Text
         else this->utf8 = nullptr;
 
         impl.mark(RenderUpdateFlag::Path);
+        changed = true;
 
         return Result::Success;
     }
@@ -86,6 +88,7 @@ struct TextImpl : Text
         this->loader = static_cast<FontLoader*>(loader);
 
         impl.mark(RenderUpdateFlag::Path);
+        changed = true;
 
         return Result::Success;
     }
@@ -107,11 +110,40 @@ struct TextImpl : Text
         if (!loader) return 0.0f;
 
         //reload
-        if (impl.marked(RenderUpdateFlag::Path)) loader->read(shape, utf8, metrics);
+        if (changed) {
+            loader->read(shape, utf8, metrics);
+            changed = false;
+        }
 
         return loader->transform(shape, metrics, fontSize, italic);
     }
 
+    bool prepare()
+    {
+        load();
+        return PAINT(shape)->prepare();
+    }
+
+    bool memory(RenderMemory& out)
+    {
+        if (loader) loader->memory(out);
+        PAINT(shape)->memory(out);
+        return true;
+    }
+
+    bool purge(bool invisible)
+    {
+        PAINT(shape)->purge(invisible);
+        return true;
+    }
+
+    bool refine(uint8_t level)
+    {
+        if (!PAINT(shape)->refine(level)) return false;
+        impl.mark(RenderUpdateFlag::Path);
+        return true;
+    }
+
     bool skip(RenderUpdateFlag flag)
     {
         if (flag == RenderUpdateFlag::None) return true;
@@ -210,25 +210,12 @@ struct WgVertexBuffer
         // decode path
         reset(scale);
 
-        PathCommand *cmds, *trimmedCmds = nullptr;
-        Point *pts, *trimmedPts = nullptr;
-        uint32_t cmdCnt{};
+        auto path = trim ? rshape.trimmedPath() : &*rshape.path;
+        if (!path) return;
 
-        if (trim) {
-            RenderPath trimmedPath;
-            if (!rshape.stroke->trim.trim(rshape.path, trimmedPath)) return;
-
-            cmds = trimmedCmds = trimmedPath.cmds.data;
-            cmdCnt = trimmedPath.cmds.count;
-            pts = trimmedPts = trimmedPath.pts.data;
-
-            trimmedPath.cmds.data = nullptr;
-            trimmedPath.pts.data = nullptr;
-        } else {
-            cmds = rshape.path.cmds.data;
-            cmdCnt = rshape.path.cmds.count;
-            pts = rshape.path.pts.data;
-        }
+        auto cmds = path->cmds.data;
+        auto cmdCnt = path->cmds.count;
+        auto pts = path->pts.data;
 
         size_t pntIndex = 0;
         for (uint32_t i = 0; i < cmdCnt; i++) {
@@ -262,9 +249,6 @@ struct WgVertexBuffer
             }
         }
 
-        tvg::free(trimmedCmds);
-        tvg::free(trimmedPts);
-
         // after path decoding we need to update distances and total length
         if (update_dist) updateDistances();
         if ((count > 0) && (onPolyline)) onPolyline(*this);
@@ -325,4 +325,48 @@ TEST_CASE("Animation Segment", "[tvgAnimation]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+
+TEST_CASE("Animation Retained Frames", "[tvgAnimation]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    const char* files[] = {TEST_DIR"/test.json", TEST_DIR"/test2.json", TEST_DIR"/test6.json", TEST_DIR"/test8.json"};
+    uint32_t buffer[100*100], buffer2[100*100];
+
+    for (auto file : files) {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(file) == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //the sequential frames must be drawn the same as the freshly built ones
+        for (auto frame = animation->totalFrame() * 0.125f; frame < animation->totalFrame(); frame += animation->totalFrame() * 0.125f) {
+            REQUIRE(animation->frame(frame) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto animation2 = unique_ptr<Animation>(Animation::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(file) == Result::Success);
+            REQUIRE(picture2->size(100, 100) == Result::Success);
+            animation2->frame(frame);
+
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(picture2) == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
\ No newline at end of file
@@ -27,6 +27,7 @@
 #endif
 #include <fstream>
 #include <cstring>
+#include <cmath>
 #include "catch.hpp"
 
 using namespace tvg;
@@ -96,6 +97,1099 @@ TEST_CASE("Lottie Slot 2", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Lottie Slot Rendering", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //a constant layer with a color slot
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":60,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":60,"st":0,"ks":{},"shapes":[)"
+                       R"({"ty":"rc","p":{"a":0,"k":[50,50]},"s":{"a":0,"k":[50,50]},"r":{"a":0,"k":0}},{"ty":"fl","c":{"sid":"color","a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+
+        uint32_t buffer[100*100], buffer2[100*100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //the frames after the first one reuse the constant layer
+        for (auto i = 1; i < 3; ++i) {
+            REQUIRE(animation->frame(10.0f * i) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        }
+        memcpy(buffer2, buffer, sizeof(buffer));
+
+        //the overridden properties must be applied to it
+        REQUIRE(animation->override(R"({"color":{"p":{"a":0,"k":[0,0,1,1]}}})") == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) != 0);
+
+        REQUIRE(animation->override(nullptr) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Keyframes", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //a spatial position, a hold keyframe of the opacity and an animated color slot
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":60,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":60,"st":0,"ks":{},"shapes":[)"
+                       R"({"ty":"rc","p":{"a":1,"k":[{"t":0,"s":[20,20],"o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1},"to":[20,0],"ti":[0,-20]},{"t":60,"s":[80,80]}]},"s":{"a":0,"k":[30,30]},"r":{"a":0,"k":0}},)"
+                       R"({"ty":"fl","c":{"sid":"color","a":1,"k":[{"t":0,"s":[1,0,0,1],"o":{"x":0,"y":0},"i":{"x":1,"y":1}},{"t":60,"s":[0,1,0,1]}]},"o":{"a":1,"k":[{"t":0,"s":[100],"h":1},{"t":30,"s":[50]}]}}]}]})";
+
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+
+        uint32_t buffer[100*100], buffer2[100*100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        auto draw = [&](float frameNo) {
+            REQUIRE(animation->frame(frameNo) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        draw(12.5f);
+        memcpy(buffer2, buffer, sizeof(buffer));
+
+        //the animated slot replaces the keyframes and the reset restores the original ones
+        REQUIRE(animation->override(R"({"color":{"p":{"a":1,"k":[{"t":0,"s":[0,0,1,1],"o":{"x":0,"y":0},"i":{"x":1,"y":1}},{"t":60,"s":[1,1,1,1]}]}}})") == Result::Success);
+        draw(37.5f);
+        draw(12.5f);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) != 0);
+
+        REQUIRE(animation->override(nullptr) == Result::Success);
+        draw(37.5f);
+        draw(12.5f);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Keyframes Seeking", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //the position and the color keyframes at the different frames
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":60,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":60,"st":0,"ks":{},"shapes":[)"
+                       R"({"ty":"rc","p":{"a":1,"k":[{"t":0,"s":[20,20],"o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1}},{"t":10,"s":[80,20],"o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1}},)"
+                       R"({"t":20,"s":[80,80],"o":{"x":0.5,"y":0},"i":{"x":0.5,"y":1}},{"t":40,"s":[20,80]},{"t":50,"s":[50,50]}]},"s":{"a":0,"k":[30,30]},"r":{"a":0,"k":0}},)"
+                       R"({"ty":"fl","c":{"a":1,"k":[{"t":0,"s":[1,0,0,1],"o":{"x":0,"y":0},"i":{"x":1,"y":1}},{"t":15,"s":[0,1,0,1]},{"t":30,"s":[0,0,1,1],"h":1},{"t":45,"s":[1,1,0,1]}]},"o":{"a":0,"k":100}}]}]})";
+
+    {
+        uint32_t buffer[100*100], buffer2[100*100];
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->picture()->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(animation->picture()) == Result::Success);
+
+        //forward within and across the keyframes, the boundaries, backward, then beyond the last one
+        for (auto frameNo : {2.0f, 7.5f, 12.0f, 20.0f, 33.0f, 29.5f, 10.0f, 9.9f, 44.0f, 55.0f, 0.5f, 30.0f}) {
+            REQUIRE(animation->frame(frameNo) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            //must be identical to the animation which never moved its cursors
+            auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(animation2->picture()->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(animation2->picture()) == Result::Success);
+            REQUIRE(animation2->frame(frameNo) == Result::Success);
+            REQUIRE(canvas2->update() == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+static double _bezier(double t, double c1, double c2)
+{
+    return 3.0 * (1.0 - t) * (1.0 - t) * t * c1 + 3.0 * (1.0 - t) * t * t * c2 + t * t * t;
+}
+
+//the eased progress by the bisection of the cubic bezier in the double precision
+static double _ease(double x, const double* curve)
+{
+    double low = 0.0, high = 1.0;
+    for (int i = 0; i < 64; ++i) {
+        auto mid = (low + high) * 0.5;
+        if (_bezier(mid, curve[0], curve[2]) < x) low = mid;
+        else high = mid;
+    }
+    return _bezier((low + high) * 0.5, curve[1], curve[3]);
+}
+
+TEST_CASE("Lottie Easing Curves", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //out x, out y, in x, in y: the ease in-out, the flat slope of x(t) in the middle, the cusp (vertical tangent) at the middle
+    const double curves[3][4] = {{0.3, 0.0, 0.7, 1.0}, {0.0, 0.5, 1.0, 0.5}, {1.0, 0.0, 0.0, 1.0}};
+    const char* names[3] = {"ease", "flat", "cusp"};
+
+    //each layer moves by 1000 pixels along its curve
+    char buf[512];
+    string data = R"({"v":"5.7.0","fr":30,"ip":0,"op":101,"w":1100,"h":100,"layers":[)";
+    for (int i = 0; i < 3; ++i) {
+        snprintf(buf, sizeof(buf), R"(%s{"ty":4,"nm":"%s","ind":%d,"ip":0,"op":101,"st":0,"ks":{"p":{"a":1,"k":[{"t":0,"s":[50,%d],"o":{"x":%g,"y":%g},"i":{"x":%g,"y":%g}},{"t":100,"s":[1050,%d]}]}},)"
+                 R"("shapes":[{"ty":"rc","p":{"a":0,"k":[0,0]},"s":{"a":0,"k":[10,10]},"r":{"a":0,"k":0}},{"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]})",
+                 i ? "," : "", names[i], i + 1, 20 + i * 30, curves[i][0], curves[i][1], curves[i][2], curves[i][3], 20 + i * 30);
+        data += buf;
+    }
+    data += "]}";
+
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data.c_str(), data.size(), "lottie+json", nullptr, true) == Result::Success);
+
+        static uint32_t buffer[1100*100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 1100, 1100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        for (int i = 0; i <= 200; ++i) {
+            auto frameNo = float(i) * 0.5f;
+            //the first frame is the current one already
+            REQUIRE(animation->frame(frameNo) == (i == 0 ? Result::InsufficientCondition : Result::Success));
+            REQUIRE(canvas->update() == Result::Success);
+
+            for (int j = 0; j < 3; ++j) {
+                float x, y, w, h;
+                REQUIRE(picture->paint(Accessor::id(names[j]))->bounds(&x, &y, &w, &h) == Result::Success);
+                auto progress = (double(x) + 5.0 - 50.0) / 1000.0;
+                //the x precision of the solver bounds t by its cube root at the singular point of the cusp
+                auto tolerance = (j == 2 && i == 100) ? 0.01 : 0.0001;
+                REQUIRE(progress == Approx(_ease(frameNo / 100.0, curves[j])).margin(tolerance));
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+//the keyframes named and unnamed eased by the given interpolators, the opacity is given by a slot
+static string _sharedEasings(uint32_t (*easing)(uint32_t))
+{
+    char buf[256];
+    string position, color;
+    for (uint32_t i = 0; i < 80; ++i) {
+        auto k = easing(i);
+        snprintf(buf, sizeof(buf), R"(%s{"t":%u,"s":[%d,50],"n":"e%02u","o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1}})", i ? "," : "", i, (i % 2) ? 80 : 20, k);
+        position += buf;
+        snprintf(buf, sizeof(buf), R"(%s{"t":%u,"s":[%d,0,0,1],"o":{"x":%.2f,"y":0},"i":{"x":0.7,"y":1}})", i ? "," : "", i, i % 2, k * 0.01);
+        color += buf;
+    }
+    return R"({"v":"5.7.0","fr":30,"ip":0,"op":100,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":100,"st":0,"ks":{},"shapes":[)"
+           R"({"ty":"rc","p":{"a":1,"k":[)" + position + R"(,{"t":80,"s":[50,50]}]},"s":{"a":0,"k":[30,30]},"r":{"a":0,"k":0}},)"
+           R"({"ty":"fl","c":{"a":1,"k":[)" + color + R"(,{"t":80,"s":[0,0,1,1]}]},"o":{"sid":"alpha","a":0,"k":100}}]}]})";
+}
+
+static size_t _sharedEasingsMemory(uint32_t (*easing)(uint32_t), const char* slot = nullptr)
+{
+    auto data = _sharedEasings(easing);
+    auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+    REQUIRE(animation->picture()->load(data.c_str(), data.size(), "lottie+json", nullptr, true) == Result::Success);
+    if (slot) REQUIRE(animation->override(slot) == Result::Success);
+
+    uint32_t buffer[100*100];
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+    REQUIRE(canvas->push(animation->picture()) == Result::Success);
+    return canvas->memory(MemoryType::Resource);
+}
+
+TEST_CASE("Lottie Shared Easings", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        //the same 40 easings in the different orders, beyond the initial capacity of the lookup index
+        auto cycled = _sharedEasingsMemory([](uint32_t i) { return i % 40; });
+        auto paired = _sharedEasingsMemory([](uint32_t i) { return i / 2; });
+        REQUIRE(cycled == paired);
+
+        //fewer interpolators are retained as fewer easings are distinct
+        REQUIRE(_sharedEasingsMemory([](uint32_t) { return 0u; }) < cycled);
+        REQUIRE(cycled < _sharedEasingsMemory([](uint32_t i) { return i; }));
+
+        //the slots reuse the interpolators of the composition
+        auto shared = _sharedEasingsMemory([](uint32_t i) { return i % 40; }, R"({"alpha":{"p":{"a":1,"k":[{"t":0,"s":[100],"n":"e05","o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1}},{"t":80,"s":[50]}]}}})");
+        auto unique = _sharedEasingsMemory([](uint32_t i) { return i % 40; }, R"({"alpha":{"p":{"a":1,"k":[{"t":0,"s":[100],"n":"z05","o":{"x":0.3,"y":0},"i":{"x":0.7,"y":1}},{"t":80,"s":[50]}]}}})");
+        REQUIRE(shared < unique);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+//a position animated by the keyframes, each of them eased by its own interpolator
+static string _easedKeyframes(uint32_t first, uint32_t cnt)
+{
+    char buf[160];
+    string data = R"({"v":"5.7.0","fr":30,"ip":0,"op":70000,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":70000,"st":0,"ks":{},"shapes":[{"ty":"rc","p":{"a":1,"k":[)";
+    for (auto i = first; i < first + cnt; ++i) {
+        if (i > first) data += ",";
+        snprintf(buf, sizeof(buf), R"({"t":%u,"s":[%d,50])", i, (i % 2) ? 80 : 20);
+        data += buf;
+        if (i == first + cnt - 1) data += "}";
+        else if (i == 65536) data += R"(,"n":"last","o":{"x":0.9,"y":0},"i":{"x":1,"y":0.1}})";
+        else {
+            //named linear easings, distinct without their lookup tables
+            snprintf(buf, sizeof(buf), R"(,"n":"ease%u","o":{"x":0,"y":0},"i":{"x":1,"y":1}})", i);
+            data += buf;
+        }
+    }
+    data += R"(]},"s":{"a":0,"k":[30,30]},"r":{"a":0,"k":0}},{"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+    return data;
+}
+
+TEST_CASE("Lottie Keyframes Easings", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        //more distinct easings than a property indexes by its interpolator table
+        auto data = _easedKeyframes(0, 65538);
+        auto data2 = _easedKeyframes(65536, 2);
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->picture()->load(data.c_str(), data.size(), "lottie+json", nullptr, true) == Result::Success);
+        auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation2->picture()->load(data2.c_str(), data2.size(), "lottie+json", nullptr, true) == Result::Success);
+
+        uint32_t buffer[100*100], buffer2[100*100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(animation->picture()) == Result::Success);
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->push(animation2->picture()) == Result::Success);
+
+        //the last easing is kept as the standalone one
+        for (auto frameNo : {65536.25f, 65536.5f, 65536.75f}) {
+            REQUIRE(animation->frame(frameNo) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            REQUIRE(animation2->frame(frameNo) == Result::Success);
+            REQUIRE(canvas2->update() == Result::Success);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+//renders the frame of the animation into the target buffer of the canvas
+static void _render(Animation* animation, Canvas* canvas, float frameNo)
+{
+    REQUIRE(animation->frame(frameNo) == Result::Success);
+    REQUIRE(canvas->update() == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+//loads the animation drawn into the buffer by its own canvas
+static void _load(unique_ptr<LottieAnimation>& animation, unique_ptr<SwCanvas>& canvas, const char* path, uint32_t* buffer, uint32_t w, uint32_t h)
+{
+    animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+    auto picture = animation->picture();
+    REQUIRE(picture->load(path) == Result::Success);
+    REQUIRE(picture->size(w, h) == Result::Success);
+
+    canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas->target(buffer, w, w, h, ColorSpace::ARGB8888) == Result::Success);
+    REQUIRE(canvas->push(picture) == Result::Success);
+}
+
+TEST_CASE("Lottie Modifier Cache", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //the rounded corners of a changing path, a changing radius and a changing polystar, each with the hold keyframes
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":20,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":20,"st":0,"ks":{},"shapes":[)"
+                       R"({"ty":"gr","it":[{"ty":"sh","ks":{"a":1,"k":[{"t":0,"s":[{"c":true,"v":[[5,5],[40,5],[40,40],[5,40]],"i":[[0,0],[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0],[0,0]]}],"h":1},)"
+                       R"({"t":10,"s":[{"c":true,"v":[[5,5],[45,5],[30,45],[5,30]],"i":[[0,0],[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0],[0,0]]}],"h":1}]}},)"
+                       R"({"ty":"rd","r":{"a":0,"k":8}},{"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]},)"
+                       R"({"ty":"gr","it":[{"ty":"sh","ks":{"a":0,"k":{"c":true,"v":[[55,5],[95,5],[95,40],[55,40]],"i":[[0,0],[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0],[0,0]]}}},)"
+                       R"({"ty":"rd","r":{"a":1,"k":[{"t":0,"s":[3],"h":1},{"t":5,"s":[15],"h":1}]}},{"ty":"fl","c":{"a":0,"k":[0,1,0,1]},"o":{"a":0,"k":100}}]},)"
+                       R"({"ty":"gr","it":[{"ty":"sr","sy":1,"d":1,"p":{"a":0,"k":[50,72]},"or":{"a":0,"k":25},"ir":{"a":0,"k":12},"os":{"a":0,"k":0},"is":{"a":0,"k":0},"r":{"a":0,"k":0},)"
+                       R"("pt":{"a":1,"k":[{"t":0,"s":[5],"h":1},{"t":15,"s":[7],"h":1}]}},{"ty":"rd","r":{"a":0,"k":4}},{"ty":"fl","c":{"a":0,"k":[0,0,1,1]},"o":{"a":0,"k":100}}]}]}]})";
+
+    {
+        uint32_t buffer[100*100], buffer2[100*100], prev[100*100];
+
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //the radius changes at 5, the path at 10 and the polystar at 15, then it goes back
+        float frames[] = {1.0f, 3.0f, 5.0f, 6.0f, 9.0f, 10.0f, 12.0f, 15.0f, 16.0f, 4.0f, 1.0f};
+        for (uint32_t i = 0; i < sizeof(frames) / sizeof(frames[0]); ++i) {
+            _render(animation.get(), canvas.get(), frames[i]);
+
+            //the reused output must be identical to a fresh build jumping straight to the frame
+            auto animation2 = unique_ptr<Animation>(Animation::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(picture2) == Result::Success);
+            _render(animation2.get(), canvas2.get(), frames[i]);
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+
+            //the changed modifier inputs must be visible
+            if (frames[i] == 5.0f || frames[i] == 10.0f || frames[i] == 15.0f) REQUIRE(memcmp(buffer, prev, sizeof(buffer)) != 0);
+            memcpy(prev, buffer, sizeof(buffer));
+        }
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Text Layout", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //the text of the local glyphs changes at 10, its size at 20 and its color at 30 with the hold keyframes
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":40,"w":100,"h":100,"fonts":{"list":[{"fName":"F","fFamily":"F","fStyle":"Regular","ascent":70}]},"chars":[)"
+                       R"({"ch":"A","size":40,"style":"Regular","fFamily":"F","w":50,"data":{"shapes":[{"ty":"gr","it":[{"ty":"sh","ks":{"a":0,"k":{"c":true,"v":[[0,0],[40,0],[20,-70]],"i":[[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0]]}}}]}]}},)"
+                       R"({"ch":"B","size":40,"style":"Regular","fFamily":"F","w":50,"data":{"shapes":[{"ty":"gr","it":[{"ty":"sh","ks":{"a":0,"k":{"c":true,"v":[[0,0],[40,0],[40,-70],[0,-70]],"i":[[0,0],[0,0],[0,0],[0,0]],"o":[[0,0],[0,0],[0,0],[0,0]]}}}]}]}}],)"
+                       R"("layers":[{"ty":5,"ind":1,"ip":0,"op":40,"st":0,"ks":{"p":{"a":0,"k":[10,50,0]}},"t":{"d":{"sid":"doc","k":[)"
+                       R"({"s":{"s":40,"f":"F","t":"AB\rB","j":0,"tr":0,"lh":40,"ls":0,"fc":[1,0,0]},"t":0},)"
+                       R"({"s":{"s":40,"f":"F","t":"BA\rA","j":0,"tr":0,"lh":40,"ls":0,"fc":[1,0,0]},"t":10},)"
+                       R"({"s":{"s":30,"f":"F","t":"BA\rA","j":0,"tr":0,"lh":40,"ls":0,"fc":[1,0,0]},"t":20},)"
+                       R"({"s":{"s":30,"f":"F","t":"BA\rA","j":0,"tr":0,"lh":40,"ls":0,"fc":[0,1,0]},"t":30}]},)"
+                       R"("p":{},"m":{"g":1,"a":{"a":0,"k":[0,0]}},"a":[]}}]})";
+    const char* slot = R"({"doc":{"p":{"k":[{"s":{"s":40,"f":"F","t":"BB","j":0,"tr":0,"lh":40,"ls":0,"fc":[0,0,1]},"t":0}]}}})";
+
+    {
+        uint32_t buffer[100*100], buffer2[100*100], prev[100*100];
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+
+        //the output must be identical to a fresh build jumping straight to the frame
+        auto verify = [&](float frameNo, const char* override) {
+            auto animation2 = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+            if (override) REQUIRE(animation2->override(override) == Result::Success);
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->push(picture2) == Result::Success);
+            _render(animation2.get(), canvas2.get(), frameNo);
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        };
+
+        //the laid out text is reused until the document changes
+        float frames[] = {1.0f, 5.0f, 10.0f, 15.0f, 20.0f, 25.0f, 30.0f, 35.0f, 3.0f};
+        for (uint32_t i = 0; i < sizeof(frames) / sizeof(frames[0]); ++i) {
+            _render(animation.get(), canvas.get(), frames[i]);
+            verify(frames[i], nullptr);
+            auto changed = (i == 0 || frames[i] == 10.0f || frames[i] == 20.0f || frames[i] == 30.0f || frames[i] == 3.0f);
+            REQUIRE((memcmp(buffer, prev, sizeof(buffer)) != 0) == changed);
+            memcpy(prev, buffer, sizeof(buffer));
+        }
+
+        //the overridden document replaces the laid out text, then the original one is back
+        REQUIRE(animation->override(slot) == Result::Success);
+        _render(animation.get(), canvas.get(), 5.0f);
+        verify(5.0f, slot);
+        REQUIRE(memcmp(buffer, prev, sizeof(buffer)) != 0);
+
+        REQUIRE(animation->override(nullptr) == Result::Success);
+        _render(animation.get(), canvas.get(), 3.0f);
+        REQUIRE(memcmp(buffer, prev, sizeof(buffer)) == 0);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Concurrent Layers", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffers[2][3][SIZE*SIZE];
+
+    //the independent layers are built on the worker threads
+    for (auto i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(i * 4) == Result::Success);
+        {
+            uint32_t buffer[SIZE*SIZE];
+            unique_ptr<LottieAnimation> animation;
+            unique_ptr<SwCanvas> canvas;
+            _load(animation, canvas, TEST_DIR"/test2.json", buffer, SIZE, SIZE);
+
+            for (auto j = 0; j < 3; ++j) {
+                _render(animation.get(), canvas.get(), animation->totalFrame() * 0.3f * (j + 1));
+                memcpy(buffers[i][j], buffer, sizeof(buffer));
+            }
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    //must be identical to the serial building
+    REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+}
+
+//the mean difference of the color channels
+static float _difference(const uint32_t* buffer, const uint32_t* buffer2, uint32_t size)
+{
+    auto sum = 0.0;
+    for (uint32_t i = 0; i < size; ++i) {
+        for (auto shift = 0; shift < 32; shift += 8) {
+            sum += abs(int((buffer[i] >> shift) & 0xff) - int((buffer2[i] >> shift) & 0xff));
+        }
+    }
+    return float(sum / (size * 4));
+}
+
+TEST_CASE("Lottie Frozen Composition", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        //Negative
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->freeze(true) == Result::InsufficientCondition);
+
+        //the precomp only rotates, the frozen one draws its contents rendered once, the other draws the vectors
+        uint32_t buffers[2][SIZE*SIZE], frames[2][SIZE*SIZE];
+        unique_ptr<LottieAnimation> animations[2];
+        unique_ptr<SwCanvas> canvases[2];
+        for (auto i = 0; i < 2; ++i) _load(animations[i], canvases[i], TEST_DIR"/test13.json", buffers[i], SIZE, SIZE);
+        REQUIRE(animations[1]->freeze(true) == Result::Success);
+
+        auto draw = [&](float frameNo) {
+            for (auto i = 0; i < 2; ++i) _render(animations[i].get(), canvases[i].get(), frameNo);
+            //the raster is resampled along the rotated edges only
+            REQUIRE(_difference(buffers[0], buffers[1], SIZE*SIZE) < 4.0f);
+        };
+
+        draw(10.0f);
+        memcpy(frames[0], buffers[1], sizeof(buffers[1]));
+        draw(20.0f);
+        memcpy(frames[1], buffers[1], sizeof(buffers[1]));
+        REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) != 0);
+
+        //the revisited frame is the same
+        draw(10.0f);
+        REQUIRE(memcmp(frames[0], buffers[1], sizeof(buffers[1])) == 0);
+
+        //rasterized again in the new scale, then back
+        for (auto i = 0; i < 2; ++i) REQUIRE(animations[i]->picture()->size(SIZE * 4, SIZE * 4) == Result::Success);
+        for (auto i = 0; i < 2; ++i) _render(animations[i].get(), canvases[i].get(), 20.0f);
+        for (auto i = 0; i < 2; ++i) REQUIRE(animations[i]->picture()->size(SIZE, SIZE) == Result::Success);
+        draw(10.0f);
+        draw(20.0f);
+        REQUIRE(memcmp(frames[1], buffers[1], sizeof(buffers[1])) == 0);
+
+        //back to the vectors
+        REQUIRE(animations[1]->freeze(false) == Result::Success);
+        draw(10.0f);
+        REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Precomp Instances", "[tvgLottie]")
+{
+    static constexpr auto W = 100, H = 50;
+    uint32_t buffers[2][W*H];
+
+    //the frozen spins are rasterized while the shared pieces are built, on the workers as well
+    for (auto threads : {0, 4}) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            //the references of the same asset at the same frame and scale share the built contents,
+            //the copies refer to the identical assets of their own
+            const char* files[] = {TEST_DIR"/test14.json", TEST_DIR"/test16.json"};
+            unique_ptr<LottieAnimation> animations[2];
+            unique_ptr<SwCanvas> canvases[2];
+            for (auto i = 0; i < 2; ++i) _load(animations[i], canvases[i], files[i], buffers[i], W, H);
+
+            auto draw = [&](float frameNo) {
+                for (auto i = 0; i < 2; ++i) _render(animations[i].get(), canvases[i].get(), frameNo);
+                REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+            };
+
+            //the late reference shows up at the frame 10, the steady dots keep their instances
+            float frames[] = {5.0f, 12.0f, 20.0f, 12.0f, 29.0f, 0.0f};
+            for (auto frameNo : frames) draw(frameNo);
+
+            //the frozen dots are rasterized by each reference
+            for (auto i = 0; i < 2; ++i) REQUIRE(animations[i]->freeze(true) == Result::Success);
+            for (auto frameNo : frames) draw(frameNo);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+TEST_CASE("Lottie Repeater Instances", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    uint32_t buffers[2][SIZE*SIZE], first[SIZE*SIZE];
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        //the repeater copies are drawn by the shape instances, the other has them as the separate shapes
+        const char* files[] = {TEST_DIR"/test15.json", TEST_DIR"/test17.json"};
+        unique_ptr<LottieAnimation> animations[2];
+        unique_ptr<SwCanvas> canvases[2];
+        for (auto i = 0; i < 2; ++i) _load(animations[i], canvases[i], files[i], buffers[i], SIZE, SIZE);
+
+        //the first frame is built before the scene is bound to the renderer, then the copies are instanced
+        for (auto i = 0; i < 2; ++i) {
+            REQUIRE(canvases[i]->draw(true) == Result::Success);
+            REQUIRE(canvases[i]->sync() == Result::Success);
+        }
+        REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+        memcpy(first, buffers[0], sizeof(first));
+
+        //the copies are moved by the whole pixels, identical to the separate shapes
+        for (auto frameNo : {29.0f, 7.0f, 18.0f, 0.0f}) {
+            for (auto i = 0; i < 2; ++i) _render(animations[i].get(), canvases[i].get(), frameNo);
+            REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+            REQUIRE((memcmp(first, buffers[0], sizeof(first)) == 0) == (frameNo == 0.0f));
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Expressions Engines", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    uint32_t buffers[2][SIZE*SIZE], buffer[SIZE*SIZE];
+
+    //each animation evaluates the expressions with its own engine, on the worker threads as well
+    for (auto threads : {0, 4}) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            unique_ptr<LottieAnimation> animations[2];
+            unique_ptr<SwCanvas> canvases[2];
+            for (auto j = 0; j < 2; ++j) _load(animations[j], canvases[j], TEST_DIR"/test6.json", buffers[j], SIZE, SIZE);
+            auto total = animations[0]->totalFrame();
+
+            for (auto progress : {0.2f, 0.4f, 0.1f}) {
+                //both are updated at the different frames before drawing
+                for (auto j = 0; j < 2; ++j) {
+                    REQUIRE(animations[j]->frame(total * progress * (j + 1)) == Result::Success);
+                    REQUIRE(canvases[j]->update() == Result::Success);
+                }
+                for (auto j = 0; j < 2; ++j) {
+                    REQUIRE(canvases[j]->draw(true) == Result::Success);
+                    REQUIRE(canvases[j]->sync() == Result::Success);
+                }
+
+                //must be identical to the animation evaluated alone
+                for (auto j = 0; j < 2; ++j) {
+                    unique_ptr<LottieAnimation> animation;
+                    unique_ptr<SwCanvas> canvas;
+                    _load(animation, canvas, TEST_DIR"/test6.json", buffer, SIZE, SIZE);
+                    _render(animation.get(), canvas.get(), total * progress * (j + 1));
+                    REQUIRE(memcmp(buffer, buffers[j], sizeof(buffer)) == 0);
+                }
+            }
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+#ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
+
+TEST_CASE("Lottie Compiled Expressions", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //the position moved by an expression with a top-level declaration, and the same motion without the expression
+    const char* data = R"({"v":"5.7.0","fr":30,"ip":0,"op":20,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":20,"st":0,"ks":{},"shapes":[)"
+                       R"({"ty":"rc","p":{"a":0,"k":[0,0],"x":"var $bm_rt;\nlet x = time * 30;\n$bm_rt = [10 + x, 50];"},"s":{"a":0,"k":[20,20]},"r":{"a":0,"k":0}},)"
+                       R"({"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+    const char* data2 = R"({"v":"5.7.0","fr":30,"ip":0,"op":20,"w":100,"h":100,"layers":[{"ty":4,"ind":1,"ip":0,"op":20,"st":0,"ks":{},"shapes":[)"
+                        R"({"ty":"rc","p":{"a":1,"k":[{"t":0,"s":[10,50],"o":{"x":0,"y":0},"i":{"x":1,"y":1}},{"t":20,"s":[30,50]}]},"s":{"a":0,"k":[20,20]},"r":{"a":0,"k":0}},)"
+                        R"({"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+
+    static constexpr float frames[] = {1.0f, 4.0f, 7.0f, 4.0f, 2.0f};
+    static constexpr auto COUNT = sizeof(frames) / sizeof(frames[0]);
+    static uint32_t expected[COUNT][100*100];
+
+    {
+        uint32_t buffer[100*100];
+
+        auto load = [&](const char* data) {
+            auto animation = unique_ptr<Animation>(Animation::gen());
+            REQUIRE(animation->picture()->load(data, strlen(data), "lottie+json", nullptr, true) == Result::Success);
+            return animation;
+        };
+
+        auto target = [&](Animation* animation) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->push(animation->picture()) == Result::Success);
+            return canvas;
+        };
+
+        auto play = [&](Animation* animation, Canvas* canvas, bool record) {
+            for (uint32_t i = 0; i < COUNT; ++i) {
+                _render(animation, canvas, frames[i]);
+                if (record) memcpy(expected[i], buffer, sizeof(buffer));
+                else REQUIRE(memcmp(expected[i], buffer, sizeof(buffer)) == 0);
+            }
+        };
+
+        {
+            auto reference = load(data2);
+            auto canvas = target(reference.get());
+            play(reference.get(), canvas.get(), true);
+        }
+
+        //the compiled code is run again over the frames, each run gives the same result
+        auto animation = load(data);
+        auto canvas = target(animation.get());
+        play(animation.get(), canvas.get(), false);
+
+        //the scripts of a released animation are discarded while the others keep theirs
+        {
+            auto animation2 = load(data);
+            auto canvas2 = target(animation2.get());
+            _render(animation2.get(), canvas2.get(), frames[0]);
+        }
+        play(animation.get(), canvas.get(), false);
+
+        //compiled again by a new animation after the former one is discarded
+        canvas.reset();
+        animation.reset();
+        auto animation2 = load(data);
+        auto canvas2 = target(animation2.get());
+        play(animation2.get(), canvas2.get(), false);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+TEST_CASE("Lottie Shared Composition", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffers[3][SIZE*SIZE];
+
+    ifstream file(TEST_DIR"/test2.json");
+    REQUIRE(file.is_open());
+    file.seekg(0, std::ios::end);
+    auto size = file.tellg();
+    auto data = (char*)malloc(size);
+    file.seekg(0, ios::beg);
+    file.read(data, size);
+    file.close();
+
+    //the animations loading the same file share its composition, but keep their own frames
+    for (auto i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(i * 4) == Result::Success);
+        {
+            unique_ptr<Animation> animations[3];
+            unique_ptr<SwCanvas> canvases[3];
+            for (auto j = 0; j < 3; ++j) {
+                animations[j] = unique_ptr<Animation>(Animation::gen());
+                auto picture = animations[j]->picture();
+                //the first one loads a private composition as the reference
+                if (j == 0) REQUIRE(picture->load(data, size, "json", "", true) == Result::Success);
+                else REQUIRE(picture->load(TEST_DIR"/test2.json") == Result::Success);
+                REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+                canvases[j] = unique_ptr<SwCanvas>(SwCanvas::gen());
+                REQUIRE(canvases[j]->target(buffers[j], SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+                REQUIRE(canvases[j]->push(picture) == Result::Success);
+            }
+
+            auto update = [&](int j, float progress) {
+                REQUIRE(animations[j]->frame(animations[j]->totalFrame() * progress) == Result::Success);
+                REQUIRE(canvases[j]->update() == Result::Success);
+                REQUIRE(canvases[j]->draw(true) == Result::Success);
+                REQUIRE(canvases[j]->sync() == Result::Success);
+            };
+
+            update(0, 0.3f);
+            update(1, 0.3f);
+            update(2, 0.6f);
+            REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+            REQUIRE(memcmp(buffers[0], buffers[2], sizeof(buffers[0])) != 0);
+
+            //the composition survives the animation which loaded it first
+            canvases[1].reset();
+            animations[1].reset();
+
+            update(0, 0.6f);
+            update(2, 0.3f);
+            update(2, 0.6f);
+            REQUIRE(memcmp(buffers[0], buffers[2], sizeof(buffers[0])) == 0);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    free(data);
+}
+
+TEST_CASE("Lottie Deferred Assets", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffers[3][SIZE*SIZE];
+
+    ifstream file(TEST_DIR"/test7.json");
+    REQUIRE(file.is_open());
+    file.seekg(0, std::ios::end);
+    auto size = file.tellg();
+    auto data = (char*)malloc(size);
+    file.seekg(0, ios::beg);
+    file.read(data, size);
+    file.close();
+
+    //the precomp assets are parsed when they show up, the copied data is parsed at loading as the reference
+    for (auto i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(i * 4) == Result::Success);
+        {
+            //the deferred assets of this are parsed from the retained source, after the file is gone
+            ofstream copy(TEST_DIR"/deferred.json", ios::binary);
+            REQUIRE(copy.is_open());
+            copy.write(data, size);
+            copy.close();
+
+            unique_ptr<Animation> animations[3];
+            unique_ptr<SwCanvas> canvases[3];
+            for (auto j = 0; j < 3; ++j) {
+                animations[j] = unique_ptr<Animation>(Animation::gen());
+                auto picture = animations[j]->picture();
+                if (j == 0) REQUIRE(picture->load(data, size, "json", "", true) == Result::Success);
+                else if (j == 1) REQUIRE(picture->load(TEST_DIR"/test7.json") == Result::Success);
+                else REQUIRE(picture->load(TEST_DIR"/deferred.json") == Result::Success);
+                REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+                canvases[j] = unique_ptr<SwCanvas>(SwCanvas::gen());
+                REQUIRE(canvases[j]->target(buffers[j], SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+                REQUIRE(canvases[j]->push(picture) == Result::Success);
+            }
+
+            REQUIRE(remove(TEST_DIR"/deferred.json") == 0);
+
+            for (auto progress : {0.9f, 0.1f, 0.5f, 0.7f}) {
+                for (auto j = 0; j < 3; ++j) {
+                    REQUIRE(animations[j]->frame(animations[j]->totalFrame() * progress) == Result::Success);
+                    REQUIRE(canvases[j]->update() == Result::Success);
+                    REQUIRE(canvases[j]->draw(true) == Result::Success);
+                    REQUIRE(canvases[j]->sync() == Result::Success);
+                }
+                REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+                REQUIRE(memcmp(buffers[0], buffers[2], sizeof(buffers[0])) == 0);
+            }
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    free(data);
+}
+
+TEST_CASE("Lottie Broken Deferred Assets", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    //the asset layers are broken, which is found when the precomp shows up
+    char data[] = R"({"v":"5.7.0","fr":30,"ip":0,"op":20,"w":100,"h":100,"assets":[{"id":"broken","layers":[{"ty":4 "ind":1}]}],"layers":[)"
+                  R"({"ty":0,"ind":1,"refId":"broken","ip":5,"op":20,"st":0,"w":100,"h":100,"ks":{}},)"
+                  R"({"ty":4,"ind":2,"ip":0,"op":20,"st":0,"ks":{},"shapes":[{"ty":"rc","p":{"a":0,"k":[50,50]},"s":{"a":0,"k":[50,50]},"r":{"a":0,"k":0}},{"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+    const char* data2 = R"({"v":"5.7.0","fr":30,"ip":0,"op":20,"w":100,"h":100,"layers":[)"
+                        R"({"ty":4,"ind":2,"ip":0,"op":20,"st":0,"ks":{},"shapes":[{"ty":"rc","p":{"a":0,"k":[50,50]},"s":{"a":0,"k":[50,50]},"r":{"a":0,"k":0}},{"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100}}]}]})";
+
+    {
+        uint32_t buffer[100*100], buffer2[100*100];
+
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(animation->picture()->load(data, strlen(data), "lottie+json", nullptr, false) == Result::Success);
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(animation->picture()) == Result::Success);
+
+        auto animation2 = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(animation2->picture()->load(data2, strlen(data2), "lottie+json", nullptr, true) == Result::Success);
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->push(animation2->picture()) == Result::Success);
+
+        //the broken precomp shows nothing, the others are drawn as usual
+        for (auto frameNo : {10.0f, 15.0f, 2.0f, 12.0f}) {
+            _render(animation.get(), canvas.get(), frameNo);
+            _render(animation2.get(), canvas2.get(), frameNo);
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Prefetch", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffers[2][SIZE*SIZE];
+
+    //nothing could be built ahead without the worker threads
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->prefetch(true) == Result::InsufficientCondition);
+        REQUIRE(animation->picture()->load(TEST_DIR"/test2.json") == Result::Success);
+        REQUIRE(animation->prefetch(true) == Result::NonSupport);
+        REQUIRE(animation->prefetch(false) == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+
+    //the frames built ahead must be identical to the ones built on demand
+    REQUIRE(Initializer::init(4) == Result::Success);
+    {
+        unique_ptr<LottieAnimation> animations[2];
+        unique_ptr<SwCanvas> canvases[2];
+        for (auto j = 0; j < 2; ++j) {
+            animations[j] = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            auto picture = animations[j]->picture();
+            REQUIRE(picture->load(TEST_DIR"/test2.json") == Result::Success);
+            REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+            canvases[j] = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvases[j]->target(buffers[j], SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvases[j]->push(picture) == Result::Success);
+        }
+        REQUIRE(animations[0]->prefetch(true) == Result::Success);
+
+        auto update = [&](float frame) {
+            for (auto j = 0; j < 2; ++j) {
+                REQUIRE(animations[j]->frame(frame) == Result::Success);
+                REQUIRE(canvases[j]->update() == Result::Success);
+                REQUIRE(canvases[j]->draw(true) == Result::Success);
+                REQUIRE(canvases[j]->sync() == Result::Success);
+            }
+            REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+        };
+
+        //the predicted frames, looping in the segment and reversed, then the mispredicted ones
+        auto total = animations[0]->totalFrame();
+        for (auto frame = total - 5.0f; frame < total + 5.0f; frame += 1.0f) update(frame < total ? frame : frame - total);
+        for (auto frame = 10.0f; frame > 0.0f; frame -= 2.0f) update(frame);
+        update(total * 0.5f);
+        update(total * 0.2f);
+
+        //back to the frames built on demand
+        REQUIRE(animations[0]->prefetch(false) == Result::Success);
+        update(total * 0.7f);
+        update(total * 0.7f + 1.0f);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Frame Cache", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffers[2][SIZE*SIZE];
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        unique_ptr<LottieAnimation> animations[2];
+        unique_ptr<SwCanvas> canvases[2];
+        for (auto j = 0; j < 2; ++j) {
+            animations[j] = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            REQUIRE(animations[j]->cache(SIZE * SIZE * 4 * 10) == Result::InsufficientCondition);
+
+            auto picture = animations[j]->picture();
+            REQUIRE(picture->load(TEST_DIR"/test2.json") == Result::Success);
+            REQUIRE(picture->size(SIZE, SIZE) == Result::Success);
+
+            canvases[j] = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvases[j]->target(buffers[j], SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvases[j]->push(picture) == Result::Success);
+        }
+
+        //the budget of the 10 frames
+        REQUIRE(animations[0]->cache(SIZE * SIZE * 4 * 10) == Result::Success);
+
+        //the rendered frames must be identical to the ones built again
+        auto update = [&](float frame) {
+            for (auto j = 0; j < 2; ++j) {
+                REQUIRE(animations[j]->frame(frame) == Result::Success);
+                REQUIRE(canvases[j]->update() == Result::Success);
+                REQUIRE(canvases[j]->draw(true) == Result::Success);
+                REQUIRE(canvases[j]->sync() == Result::Success);
+            }
+            REQUIRE(memcmp(buffers[0], buffers[1], sizeof(buffers[0])) == 0);
+        };
+
+        //the frames out of the budget are built again in the next loops
+        for (auto loop = 0; loop < 3; ++loop) {
+            for (auto frame = 1.0f; frame < 16.0f; frame += 1.0f) update(frame);
+        }
+        REQUIRE(canvases[0]->memory(MemoryType::Image) >= SIZE * SIZE * 4 * 10);
+        REQUIRE(canvases[1]->memory(MemoryType::Image) == 0);
+
+        //the frames of the previous size are released
+        for (auto j = 0; j < 2; ++j) {
+            REQUIRE(animations[j]->picture()->size(SIZE / 2, SIZE / 2) == Result::Success);
+        }
+        for (auto frame = 3.0f; frame < 6.0f; frame += 1.0f) update(frame);
+        for (auto frame = 3.0f; frame < 6.0f; frame += 1.0f) update(frame);
+
+        //disabled
+        REQUIRE(animations[0]->cache(0) == Result::Success);
+        update(7.0f);
+        REQUIRE(canvases[0]->memory(MemoryType::Image) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Frame Range Rendering", "[tvgLottie]")
+{
+    static constexpr auto SIZE = 100;
+    static uint32_t buffer[SIZE*SIZE];
+
+    struct Context
+    {
+        LottieAnimation* reference;
+        SwCanvas* canvas;
+        float frameNo;
+        uint32_t frames;
+        uint32_t stop;
+    };
+
+    //the frames must be delivered in order, identical to the ones rendered one by one
+    auto func = [](const uint32_t* image, uint32_t w, uint32_t h, float frameNo, void* data) {
+        auto ctx = static_cast<Context*>(data);
+        if (w != SIZE || h != SIZE || frameNo <= ctx->frameNo) return false;
+        ctx->frameNo = frameNo;
+        ctx->reference->frame(frameNo);
+        ctx->canvas->update();
+        ctx->canvas->draw(true);
+        ctx->canvas->sync();
+        if (memcmp(image, buffer, sizeof(buffer))) return false;
+        return ++ctx->frames != ctx->stop;
+    };
+
+    REQUIRE(Initializer::init(4) == Result::Success);
+    {
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(animation->render(0, 10, 1, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InsufficientCondition);
+
+        REQUIRE(animation->picture()->load(TEST_DIR"/test2.json") == Result::Success);
+        REQUIRE(animation->picture()->size(SIZE, SIZE) == Result::Success);
+
+        auto reference = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        REQUIRE(reference->picture()->load(TEST_DIR"/test2.json") == Result::Success);
+        REQUIRE(reference->picture()->size(SIZE, SIZE) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, SIZE, SIZE, SIZE, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(reference->picture()) == Result::Success);
+
+        //invalid arguments
+        REQUIRE(animation->render(0, 10, 1, 0, ColorSpace::ARGB8888, nullptr, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, 10, 0, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(10, 0, 1, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, 10, 1, 0, ColorSpace::Grayscale8, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, 10, NAN, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, 10, INFINITY, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(NAN, 10, 1, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, INFINITY, 1, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+        REQUIRE(animation->render(0, 10, 1e-30f, 0, ColorSpace::ARGB8888, func, nullptr) == Result::InvalidArguments);
+
+        REQUIRE(animation->frame(5) == Result::Success);
+
+        Context ctx = {reference.get(), canvas.get(), -1.0f, 0, 0};
+        REQUIRE(animation->render(1, 21, 1, 0, ColorSpace::ARGB8888, func, &ctx) == Result::Success);
+        REQUIRE(ctx.frames == 20);
+
+        //a single worker with the fractional frames
+        ctx = {reference.get(), canvas.get(), -1.0f, 0, 0};
+        REQUIRE(animation->render(0, 5, 0.5f, 1, ColorSpace::ARGB8888, func, &ctx) == Result::Success);
+        REQUIRE(ctx.frames == 10);
+
+        //stopped by the callback
+        ctx = {reference.get(), canvas.get(), -1.0f, 0, 3};
+        REQUIRE(animation->render(0, animation->totalFrame(), 1, 2, ColorSpace::ARGB8888, func, &ctx) == Result::Success);
+        REQUIRE(ctx.frames == 3);
+
+        //the current frame is kept
+        REQUIRE(animation->curFrame() == 5.0f);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Model Memory", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto small = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(small->picture()->load(TEST_DIR"/test.json") == Result::Success);
+        auto large = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(large->picture()->load(TEST_DIR"/test2.json") == Result::Success);
+        auto other = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(other->picture()->load(TEST_DIR"/test5.json") == Result::Success);
+
+        uint32_t buffer[100*100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->memory(MemoryType::Resource) == 0);
+
+        //the source data is released after parsing, the model is retained
+        REQUIRE(canvas->push(small->picture()) == Result::Success);
+        auto model = canvas->memory(MemoryType::Resource);
+        REQUIRE(model > 0);
+
+        //a larger model
+        REQUIRE(canvas2->push(large->picture()) == Result::Success);
+        REQUIRE(canvas2->memory(MemoryType::Resource) > model);
+
+        //grows with the loaded models
+        REQUIRE(canvas->push(other->picture()) == Result::Success);
+        REQUIRE(canvas->memory(MemoryType::Resource) > model);
+
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(canvas->memory() >= canvas->memory(MemoryType::Resource));
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 TEST_CASE("Lottie Marker", "[tvgLottie]")
 {
     REQUIRE(Initializer::init(0) == Result::Success);
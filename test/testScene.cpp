@@ -21,6 +21,8 @@
  */
 
 #include <thorvg.h>
+#include <cstring>
+#include <thread>
 #include "config.h"
 #include "catch.hpp"
 
@@ -103,3 +105,194 @@ TEST_CASE("Scene Clear And Reuse Shape", "[tvgScene]")
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
+
+static Scene* _buildScene()
+{
+    auto scene = Scene::gen();
+
+    for (int i = 0; i < 10; ++i) {
+        auto shape = Shape::gen();
+        shape->appendCircle(10 + i * 8, 50, 8, 30);
+        shape->fill(i * 20, 100, 255 - i * 20);
+        shape->strokeFill(0, 0, 0);
+        shape->strokeWidth(2);
+        shape->trimpath(0.1f, 0.8f);
+        scene->push(shape);
+    }
+    return scene;
+}
+
+TEST_CASE("Scene Swapping Into Canvas", "[tvgScene]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100];
+        uint32_t buffer2[100*100];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto front = Shape::gen();
+        front->appendRect(0, 0, 100, 100);
+        front->fill(255, 255, 255);
+        auto prev = Shape::gen();
+        prev->appendRect(10, 10, 50, 50);
+        auto back = Shape::gen();
+        back->appendRect(40, 40, 50, 50);
+        back->fill(255, 0, 0, 128);
+
+        REQUIRE(canvas->push(front) == Result::Success);
+        REQUIRE(canvas->push(prev) == Result::Success);
+        REQUIRE(canvas->push(back) == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+
+        //Build the next content on a worker while the canvas is drawing
+        Scene* scene = nullptr;
+        std::thread worker([&scene] {
+            scene = _buildScene();
+            scene->prepare();
+        });
+        REQUIRE(canvas->sync() == Result::Success);
+        worker.join();
+
+        //Negative cases
+        REQUIRE(canvas->swap(nullptr, scene) == Result::InvalidArguments);
+        REQUIRE(canvas->swap(prev, nullptr) == Result::InvalidArguments);
+        REQUIRE(canvas->swap(scene, prev) == Result::InsufficientCondition);
+        REQUIRE(canvas->swap(prev, front) == Result::InsufficientCondition);
+
+        REQUIRE(canvas->swap(prev, scene) == Result::Success);
+        auto& paints = canvas->paints();
+        REQUIRE(paints.size() == 3);
+        REQUIRE(*std::next(paints.begin()) == scene);
+        REQUIRE(scene->parent() == front->parent());
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //Same as the content pushed in the order
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->push(front->duplicate()) == Result::Success);
+        REQUIRE(canvas2->push(_buildScene()) == Result::Success);
+        REQUIRE(canvas2->push(back->duplicate()) == Result::Success);
+        REQUIRE(canvas2->draw() == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+static void _buildContent(Canvas* canvas, Scene** hidden)
+{
+    *hidden = _buildScene();
+    (*hidden)->translate(0, 20);
+
+    auto fill = LinearGradient::gen();
+    fill->linear(0, 0, 100, 100);
+    Fill::ColorStop stops[2] = {{0.0f, 255, 0, 0, 255}, {1.0f, 0, 0, 255, 255}};
+    fill->colorStops(stops, 2);
+    auto gradient = Shape::gen();
+    gradient->appendRect(0, 60, 100, 40);
+    gradient->fill(fill);
+    gradient->opacity(128);
+
+    canvas->push(_buildScene());
+    canvas->push(*hidden);
+    canvas->push(gradient);
+}
+
+TEST_CASE("Scene Memory Purging", "[tvgScene]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100];
+        uint32_t buffer2[100*100];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->memory(MemoryType::Gradient) == 0);
+
+        Scene* hidden;
+        _buildContent(canvas.get(), &hidden);
+        REQUIRE(canvas->draw(true) == Result::Success);
+
+        //Not allowed while drawing
+        REQUIRE(canvas->purge() == Result::InsufficientCondition);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->memory(MemoryType::Geometry) > 0);
+        REQUIRE(canvas->memory(MemoryType::Gradient) > 0);
+        REQUIRE(canvas->memory(MemoryType::Image) == 0);
+        auto total = canvas->memory();
+        REQUIRE(total == canvas->memory(MemoryType::Geometry) + canvas->memory(MemoryType::Gradient) + canvas->memory(MemoryType::Compositor) + canvas->memory(MemoryType::Resource));
+        REQUIRE(Initializer::memory() > 0);
+
+        REQUIRE(hidden->opacity(0) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //The render data of the invisible paints are released
+        auto geometry = canvas->memory(MemoryType::Geometry);
+        REQUIRE(canvas->purge() == Result::Success);
+        REQUIRE(canvas->memory(MemoryType::Geometry) < geometry);
+        REQUIRE(canvas->memory(MemoryType::Gradient) > 0);
+
+        //Regenerated on demand
+        REQUIRE(hidden->opacity(255) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        _buildContent(canvas2.get(), &hidden);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Scene Duplication Drawing", "[tvgScene]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100];
+        uint32_t buffer2[100*100];
+
+        //a blended child under the post effects
+        auto scene = Scene::gen();
+        auto base = Shape::gen();
+        REQUIRE(base->appendRect(10, 10, 60, 60) == Result::Success);
+        REQUIRE(base->fill(255, 0, 0) == Result::Success);
+        REQUIRE(scene->push(base) == Result::Success);
+
+        auto blended = Shape::gen();
+        REQUIRE(blended->appendCircle(60, 60, 30, 30) == Result::Success);
+        REQUIRE(blended->fill(0, 0, 255) == Result::Success);
+        REQUIRE(blended->blend(BlendMethod::Difference) == Result::Success);
+        REQUIRE(scene->push(blended) == Result::Success);
+
+        REQUIRE(scene->push(SceneEffect::DropShadow, 0, 0, 0, 128, 45.0, 5.0, 2.0, 60) == Result::Success);
+        REQUIRE(scene->push(SceneEffect::Tint, 0, 0, 0, 255, 255, 255, 50.0) == Result::Success);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->push(scene->duplicate()) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->remove() == Result::Success);
+        REQUIRE(canvas->push(scene) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the duplicated one keeps the blending and the effects
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
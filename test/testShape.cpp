@@ -21,6 +21,7 @@
  */
 
 #include <thorvg.h>
+#include <cstring>
 #include "config.h"
 #include "catch.hpp"
 
@@ -129,6 +130,93 @@ TEST_CASE("Appending Paths", "[tvgShape]")
     REQUIRE(pts2Cnt == 0);
 }
 
+TEST_CASE("Borrowing Paths", "[tvgShape]")
+{
+    auto shape = unique_ptr<Shape>(Shape::gen());
+    REQUIRE(shape);
+
+    //Negative cases
+    REQUIRE(shape->borrowPath(nullptr, 0, nullptr, 0) == Result::InvalidArguments);
+    REQUIRE(shape->borrowPath(nullptr, 100, nullptr, 100) == Result::InvalidArguments);
+
+    PathCommand cmds[4] = {PathCommand::MoveTo, PathCommand::LineTo, PathCommand::LineTo, PathCommand::Close};
+    Point pts[3] = {{10, 10}, {90, 10}, {50, 90}};
+
+    REQUIRE(shape->borrowPath(cmds, 0, pts, 3) == Result::InvalidArguments);
+    REQUIRE(shape->borrowPath(cmds, 4, pts, 0) == Result::InvalidArguments);
+
+    //The previous path is replaced, the buffers are referred without copying
+    REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+    REQUIRE(shape->borrowPath(cmds, 4, pts, 3) == Result::Success);
+
+    const PathCommand* cmds2;
+    const Point* pts2;
+    uint32_t cmds2Cnt, pts2Cnt;
+    REQUIRE(shape->path(&cmds2, &cmds2Cnt, &pts2, &pts2Cnt) == Result::Success);
+    REQUIRE(cmds2 == cmds);
+    REQUIRE(pts2 == pts);
+    REQUIRE(cmds2Cnt == 4);
+    REQUIRE(pts2Cnt == 3);
+
+    //The duplicate owns a copy
+    auto dup = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(dup->path(&cmds2, &cmds2Cnt, &pts2, &pts2Cnt) == Result::Success);
+    REQUIRE(cmds2 != cmds);
+    REQUIRE(pts2 != pts);
+    REQUIRE(cmds2Cnt == 4);
+    REQUIRE(pts2[2].y == 90);
+
+    //Drawing
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100];
+        uint32_t buffer2[100*100];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto borrowed = Shape::gen();
+        REQUIRE(borrowed->borrowPath(cmds, 4, pts, 3) == Result::Success);
+        REQUIRE(borrowed->fill(255, 0, 0) == Result::Success);
+        REQUIRE(canvas->push(borrowed) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto copied = Shape::gen();
+        REQUIRE(copied->appendPath(cmds, 4, pts, 3) == Result::Success);
+        REQUIRE(copied->fill(255, 0, 0) == Result::Success);
+        REQUIRE(canvas2->push(copied) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+
+        //The updated buffers contents are applied once borrowed again
+        pts[2] = {50, 50};
+        REQUIRE(borrowed->borrowPath(cmds, 4, pts, 3) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) != 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+
+    //Modifying the path copies the borrowed data first
+    REQUIRE(shape->lineTo(0, 0) == Result::Success);
+    REQUIRE(shape->path(&cmds2, &cmds2Cnt, &pts2, &pts2Cnt) == Result::Success);
+    REQUIRE(cmds2 != cmds);
+    REQUIRE(cmds2Cnt == 5);
+    REQUIRE(pts2Cnt == 4);
+    REQUIRE(cmds[3] == PathCommand::Close);
+
+    REQUIRE(shape->borrowPath(cmds, 4, pts, 3) == Result::Success);
+    REQUIRE(shape->reset() == Result::Success);
+    REQUIRE(shape->path(nullptr, &cmds2Cnt, nullptr, &pts2Cnt) == Result::Success);
+    REQUIRE(cmds2Cnt == 0);
+    REQUIRE(pts2Cnt == 0);
+}
+
 TEST_CASE("Stroking", "[tvgShape]")
 {
     auto shape = unique_ptr<Shape>(Shape::gen());
@@ -223,3 +311,306 @@ TEST_CASE("Shape Filling", "[tvgShape]")
     REQUIRE(shape->fill(FillRule::EvenOdd) == Result::Success);
     REQUIRE(shape->fillRule() == FillRule::EvenOdd);
 }
+
+TEST_CASE("Shape Duplication", "[tvgShape]")
+{
+    auto shape = unique_ptr<Shape>(Shape::gen());
+    REQUIRE(shape);
+
+    REQUIRE(shape->appendRect(0, 0, 100, 100) == Result::Success);
+    REQUIRE(shape->strokeWidth(3) == Result::Success);
+    float dashPattern[2] = {2.5f, 5.0f};
+    REQUIRE(shape->strokeDash(dashPattern, 2) == Result::Success);
+
+    auto dup = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(dup);
+
+    //The path data is shared until modified
+    const PathCommand *cmds, *cmds2;
+    const Point *pts, *pts2;
+    uint32_t cmdsCnt, cmdsCnt2, ptsCnt, ptsCnt2;
+    REQUIRE(shape->path(&cmds, &cmdsCnt, &pts, &ptsCnt) == Result::Success);
+    REQUIRE(dup->path(&cmds2, &cmdsCnt2, &pts2, &ptsCnt2) == Result::Success);
+    REQUIRE(cmds == cmds2);
+    REQUIRE(pts == pts2);
+
+    REQUIRE(dup->lineTo(50, 50) == Result::Success);
+    REQUIRE(dup->path(&cmds2, &cmdsCnt2, &pts2, &ptsCnt2) == Result::Success);
+    REQUIRE(cmds != cmds2);
+    REQUIRE(cmdsCnt2 == cmdsCnt + 1);
+    REQUIRE(shape->path(&cmds, &cmdsCnt, &pts, &ptsCnt) == Result::Success);
+    REQUIRE(cmdsCnt == 5);
+    REQUIRE(ptsCnt == 4);
+
+    //The stroke properties are shared until modified
+    const float* dash;
+    const float* dash2;
+    REQUIRE(shape->strokeDash(&dash) == 2);
+    REQUIRE(dup->strokeDash(&dash2) == 2);
+    REQUIRE(dash == dash2);
+
+    REQUIRE(dup->strokeWidth(5) == Result::Success);
+    REQUIRE(shape->strokeWidth() == 3);
+    REQUIRE(dup->strokeWidth() == 5);
+    REQUIRE(dup->strokeDash(&dash2) == 2);
+    REQUIRE(dash != dash2);
+
+    //Resetting a shared path leaves the other one
+    REQUIRE(shape->reset() == Result::Success);
+    REQUIRE(dup->path(nullptr, &cmdsCnt2, nullptr, nullptr) == Result::Success);
+    REQUIRE(cmdsCnt2 == 6);
+}
+
+TEST_CASE("Shape Instancing", "[tvgShape]")
+{
+    auto shape = unique_ptr<Shape>(Shape::gen());
+    REQUIRE(shape);
+
+    REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+
+    Matrix transforms[2] = {{1, 0, 0, 0, 1, 0, 0, 0, 1}, {1, 0, 90, 0, 1, 40, 0, 0, 1}};
+    uint8_t colors[8] = {255, 0, 0, 255, 0, 255, 0, 255};
+    uint8_t opacities[2] = {255, 128};
+
+    //Invalid Arguments
+    REQUIRE(shape->instances(nullptr, 2) == Result::InvalidArguments);
+
+    REQUIRE(shape->instances(transforms, 2) == Result::Success);
+    REQUIRE(shape->instances(transforms, 2, colors, opacities) == Result::Success);
+
+    //Bounds cover all the instances
+    float x, y, w, h;
+    REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(x == Approx(0.0f).margin(0.000001));
+    REQUIRE(y == Approx(0.0f).margin(0.000001));
+    REQUIRE(w == Approx(100.0f).margin(0.000001));
+    REQUIRE(h == Approx(50.0f).margin(0.000001));
+
+    //Duplication keeps the instances
+    auto dup = unique_ptr<Shape>(static_cast<Shape*>(shape->duplicate()));
+    REQUIRE(dup);
+    REQUIRE(dup->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(w == Approx(100.0f).margin(0.000001));
+
+    //Reset
+    REQUIRE(shape->instances(nullptr, 0) == Result::Success);
+    REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+    REQUIRE(w == Approx(10.0f).margin(0.000001));
+    REQUIRE(h == Approx(10.0f).margin(0.000001));
+}
+
+static void _star(Shape* shape, bool stroke)
+{
+    shape->moveTo(15, 0);
+    shape->lineTo(20, 10);
+    shape->lineTo(30, 12);
+    shape->lineTo(22, 20);
+    shape->lineTo(25, 30);
+    shape->lineTo(15, 25);
+    shape->lineTo(5, 30);
+    shape->lineTo(8, 20);
+    shape->lineTo(0, 12);
+    shape->lineTo(10, 10);
+    shape->close();
+    if (stroke) {
+        shape->strokeFill(255, 255, 255, 255);
+        shape->strokeWidth(2);
+    }
+}
+
+static void _drawInstances(bool stroke, const uint8_t* opacities)
+{
+    uint32_t buffer[100*100];
+    uint32_t buffer2[100*100];
+
+    //integer translations share the spans, the fractional ones share the outline, the scaled one has its own geometry
+    Matrix transforms[4] = {{1, 0, -10, 0, 1, 10, 0, 0, 1}, {1, 0, 50, 0, 1, 20, 0, 0, 1}, {1, 0, 20.3f, 0, 1, 60.7f, 0, 0, 1}, {2, 0, 40, 0, 2, 50, 0, 0, 1}};
+    uint8_t colors[16] = {255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 0, 255};
+
+    //Instanced
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+    auto shape = Shape::gen();
+    _star(shape, stroke);
+    REQUIRE(shape->instances(transforms, 4, colors, opacities) == Result::Success);
+    REQUIRE(canvas->push(shape) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+
+    //Individual shapes
+    auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+    for (int i = 0; i < 4; ++i) {
+        auto shape = Shape::gen();
+        _star(shape, stroke);
+        shape->fill(colors[i * 4], colors[i * 4 + 1], colors[i * 4 + 2], colors[i * 4 + 3]);
+        shape->transform(transforms[i]);
+        shape->opacity(opacities[i]);
+        REQUIRE(canvas2->push(shape) == Result::Success);
+    }
+    REQUIRE(canvas2->draw(true) == Result::Success);
+    REQUIRE(canvas2->sync() == Result::Success);
+
+    REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+}
+
+TEST_CASE("Instanced Drawing", "[tvgShape]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    uint8_t opaque[4] = {255, 255, 255, 255};
+    uint8_t translucent[4] = {255, 128, 255, 64};
+
+    _drawInstances(true, opaque);
+    _drawInstances(false, translucent);
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+static void _drawFreshInstances(uint32_t* buffer, const Matrix* transforms, const uint8_t* colors, const uint8_t* opacities, float trim)
+{
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+    auto shape = Shape::gen();
+    _star(shape, true);
+    REQUIRE(shape->trimpath(0.0f, trim) == Result::Success);
+    REQUIRE(shape->instances(transforms, 4, colors, opacities) == Result::Success);
+    REQUIRE(canvas->push(shape) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+TEST_CASE("Instanced Update", "[tvgShape]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    {
+        uint32_t buffer[100*100];
+        uint32_t buffer2[100*100];
+
+        Matrix transforms[4] = {{1, 0, -10, 0, 1, 10, 0, 0, 1}, {1, 0, 50, 0, 1, 20, 0, 0, 1}, {1, 0, 20.3f, 0, 1, 60.7f, 0, 0, 1}, {2, 0, 40, 0, 2, 50, 0, 0, 1}};
+        uint8_t colors[16] = {255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 0, 255};
+        uint8_t opacities[4] = {255, 255, 255, 255};
+        auto trim = 1.0f;
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape = Shape::gen();
+        _star(shape, true);
+        REQUIRE(canvas->push(shape) == Result::Success);
+
+        //the retained instances must follow every kind of change as if they were built from scratch
+        for (int step = 0; step < 7; ++step) {
+            if (step == 1) colors[0] = 0;                                       //colors only
+            else if (step == 2) transforms[1].e13 = 30;                         //integer translation
+            else if (step == 3) transforms[2].e13 = 10.6f;                      //fractional translation
+            else if (step == 4) transforms[3].e11 = transforms[3].e22 = 1.5f;   //unique geometry
+            else if (step == 5) opacities[1] = 0;                               //hidden
+            else if (step == 6) trim = 0.5f;                                    //the base geometry
+
+            REQUIRE(shape->trimpath(0.0f, trim) == Result::Success);
+            REQUIRE(shape->instances(transforms, 4, colors, opacities) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            _drawFreshInstances(buffer2, transforms, colors, opacities, trim);
+            REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Instanced Bounds", "[tvgShape]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        auto shape = unique_ptr<Shape>(Shape::gen());
+        REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+
+        Matrix transforms[2] = {{1, 0, 0, 0, 1, 0, 0, 0, 1}, {1, 0, 20, 0, 1, 0, 0, 0, 1}};
+        REQUIRE(shape->instances(transforms, 2, nullptr, nullptr) == Result::Success);
+        REQUIRE(shape->rotate(90.0f) == Result::Success);
+
+        //axis-aligned box of the rotated instances
+        float x, y, w, h;
+        REQUIRE(shape->bounds(&x, &y, &w, &h) == Result::Success);
+        REQUIRE(x == Approx(-10.0f).margin(0.0001f));
+        REQUIRE(y == Approx(0.0f).margin(0.0001f));
+        REQUIRE(w == Approx(10.0f).margin(0.0001f));
+        REQUIRE(h == Approx(30.0f).margin(0.0001f));
+
+        //oriented box follows the rotation
+        Point pt4[4];
+        REQUIRE(shape->bounds(pt4) == Result::Success);
+        Point expected[4] = {{0, 0}, {0, 30}, {-10, 30}, {-10, 0}};
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(pt4[i].x == Approx(expected[i].x).margin(0.0001f));
+            REQUIRE(pt4[i].y == Approx(expected[i].y).margin(0.0001f));
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+static Fill* _gradient(uint8_t r)
+{
+    Fill::ColorStop cs[2] = {{0.0f, r, 0, 0, 255}, {1.0f, 0, 0, 255, 255}};
+    auto fill = LinearGradient::gen();
+    fill->colorStops(cs, 2);
+    fill->linear(0.0f, 0.0f, 100.0f, 100.0f);
+    return fill;
+}
+
+static void _drawOffscreenGradient()
+{
+    uint32_t buffer[100*100];
+    uint32_t buffer2[100*100];
+
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+    auto shape = Shape::gen();
+    REQUIRE(shape->appendRect(0, 0, 100, 100) == Result::Success);
+    REQUIRE(shape->fill(_gradient(255)) == Result::Success);
+    REQUIRE(shape->translate(200, 0) == Result::Success);
+    REQUIRE(canvas->push(shape) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+
+    //the gradient is changed while the shape is out of the canvas
+    REQUIRE(shape->fill(_gradient(128)) == Result::Success);
+    REQUIRE(canvas->update() == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+
+    //the shape comes back with the same gradient
+    REQUIRE(shape->translate(0, 0) == Result::Success);
+    REQUIRE(canvas->update() == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+
+    auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas2->target(buffer2, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+    auto shape2 = Shape::gen();
+    REQUIRE(shape2->appendRect(0, 0, 100, 100) == Result::Success);
+    REQUIRE(shape2->fill(_gradient(128)) == Result::Success);
+    REQUIRE(canvas2->push(shape2) == Result::Success);
+    REQUIRE(canvas2->draw(true) == Result::Success);
+    REQUIRE(canvas2->sync() == Result::Success);
+
+    REQUIRE(memcmp(buffer, buffer2, sizeof(buffer)) == 0);
+}
+
+TEST_CASE("Offscreen Gradient Drawing", "[tvgShape]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+
+    _drawOffscreenGradient();
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
@@ -26,6 +26,87 @@
 
 using namespace tvg;
 using namespace std;
+
+static bool _antialiased(const uint32_t* buffer, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i) {
+        auto a = buffer[i] >> 24;
+        if (a > 0 && a < 255) return true;
+    }
+    return false;
+}
+
+TEST_CASE("Frame Budget", "[tvgSwCanvas]")
+{
+    REQUIRE(Initializer::init(0) == Result::Success);
+    {
+        uint32_t buffer[100*100];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //Negative
+        REQUIRE(canvas->budget(-1.0f) == Result::InvalidArguments);
+
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendCircle(50, 50, 40, 40) == Result::Success);
+        REQUIRE(shape->fill(255, 255, 255, 255) == Result::Success);
+        REQUIRE(canvas->push(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(_antialiased(buffer, 100*100));
+
+        REQUIRE(canvas->quality() == 3);
+        REQUIRE(canvas->budget(0.00001f) == Result::Success);
+
+        //every frame overruns the budget, the quality is lowered one by one
+        for (int i = 0; i < 4; ++i) {
+            auto quality = canvas->quality();
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->budget(0.0f) == Result::InsufficientCondition);
+            REQUIRE(canvas->sync() == Result::Success);
+            REQUIRE(canvas->quality() == (quality > 0 ? quality - 1 : 0));
+        }
+
+        //the unchanged shape keeps its former result
+        REQUIRE(_antialiased(buffer, 100*100));
+
+        //the updated shape takes the lowered quality
+        REQUIRE(shape->translate(1, 0) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(!_antialiased(buffer, 100*100));
+
+        //the frames finished within the half budget restore one level
+        REQUIRE(canvas->budget(10000.0f) == Result::Success);
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(canvas->quality() == 0);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        }
+        REQUIRE(canvas->quality() == 1);
+
+        //the unchanged shape lowered before is antialiased again by the next update
+        REQUIRE(!_antialiased(buffer, 100*100));
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(_antialiased(buffer, 100*100));
+
+        //disabled, the full quality is restored
+        REQUIRE(canvas->budget(0.0f) == Result::Success);
+        REQUIRE(canvas->quality() == 3);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(canvas->quality() == 3);
+        REQUIRE(_antialiased(buffer, 100*100));
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #if 0
 TEST_CASE("Missing Initialization", "[tvgSwCanvas]")
 {
@@ -342,4 +423,4 @@ TEST_CASE("Viewport", "[tvgSwCanvas]")
 
     REQUIRE(Initializer::term() == Result::Success);
 }
-#endif
\ No newline at end of file
+#endif